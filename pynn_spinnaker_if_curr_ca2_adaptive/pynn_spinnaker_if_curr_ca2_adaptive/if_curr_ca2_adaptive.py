@@ -12,6 +12,7 @@ from pyNN.standardmodels import build_translations
 from pynn_spinnaker.standardmodels.cells import calc_max_neurons_per_core
 
 # Import globals
+from model_costs import neuron_update_cpu_cycles, synapse_shape_cpu_cycles
 from pynn_spinnaker.standardmodels.cells import (exp_synapse_translations,
                                                  exp_synapse_immutable_param_map,
                                                  exp_synapse_curr_mutable_param_map)
@@ -82,7 +83,7 @@ class IF_curr_ca2_adaptive_exp(StandardCellType):
         "v_reset"    : -65.0,   # Reset potential after a spike in mV.
         "v_thresh"   : -50.0,   # Spike threshold in mV.
     }
-    recordable = ["spikes", "v"]
+    recordable = ["spikes", "v", "i_ca2"]
     conductance_based = False
     default_initial_values = {
         "v": -65.0,  # 'v_rest',
@@ -117,8 +118,9 @@ class IF_curr_ca2_adaptive_exp(StandardCellType):
     # --------------------------------------------------------------------------
     # Internal SpiNNaker methods
     # --------------------------------------------------------------------------
-    # How many of these neurons per core can
-    # a SpiNNaker neuron processor handle
-    _calc_max_neurons_per_core = partial(calc_max_neurons_per_core,
-                                         neuron_update_cpu_cycles=175,
-                                         synapse_shape_cpu_cycles=28)
\ No newline at end of file
+    # How many of these neurons per core can a SpiNNaker neuron processor
+    # handle - costs are generated by runtime/benchmark/model_benchmark
+    _calc_max_neurons_per_core = partial(
+        calc_max_neurons_per_core,
+        neuron_update_cpu_cycles=neuron_update_cpu_cycles["CA2Adaptive"],
+        synapse_shape_cpu_cycles=synapse_shape_cpu_cycles["Exp"])
@@ -0,0 +1,14 @@
+# Generated by runtime/benchmark/model_benchmark - do not edit
+# Worst-case cost of each model in SpiNNaker CPU cycles per neuron per timestep
+# Calibration error against costs profiled on SpiNNaker:
+#   ReferenceIFCurr: 148.6 cycles, profiled 143 (+4.0%)
+#   CA2Adaptive: 167.5 cycles, profiled 175 (-4.3%)
+#   ReferenceExp: 29.6 cycles, profiled 28 (+5.9%)
+#   ReferenceDualExp: 43.9 cycles, profiled 47 (-6.6%)
+neuron_update_cpu_cycles = {
+    "CA2Adaptive": 168,
+}
+
+synapse_shape_cpu_cycles = {
+    "Exp": 30,
+}
@@ -0,0 +1,618 @@
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Rig CPP common includes
+#include "rig_cpp_common/fixed_point_number.h"
+#include "rig_cpp_common/log.h"
+
+// Extra model includes
+// **NOTE** these rely on logging having already been included
+#include "../ca2_adaptive.h"
+
+// Namespaces
+using namespace Common::FixedPointNumber;
+using namespace ExtraModels;
+
+//-----------------------------------------------------------------------------
+// Anonymous namespace
+//-----------------------------------------------------------------------------
+namespace
+{
+//-----------------------------------------------------------------------------
+// Constants
+//-----------------------------------------------------------------------------
+// Number of neurons updated each simulated timestep
+const unsigned int NumNeurons = 256;
+
+// Number of times each measurement is repeated (the cheapest is used)
+const unsigned int NumRepeats = 25;
+
+// Simulation timestep [ms]
+const double Timestep = 0.1;
+
+// Costs of models measured on SpiNNaker with the profiler, to which
+// the conversion of host costs into SpiNNaker CPU cycles is fitted
+const double ReferenceIFCurrCycles = 143.0;
+const double CA2AdaptiveCycles = 175.0;
+const double ReferenceExpCycles = 28.0;
+const double ReferenceDualExpCycles = 47.0;
+
+//-----------------------------------------------------------------------------
+// Mix
+//-----------------------------------------------------------------------------
+// Input mixes under which each model is measured
+enum Mix
+{
+  MixIdle,
+  MixSpiking,
+  MixRefractory,
+  MixMax,
+};
+
+const char *MixNames[MixMax] = {"idle", "spiking", "refractory"};
+
+//-----------------------------------------------------------------------------
+// ReferenceIFCurr
+//-----------------------------------------------------------------------------
+// Copy of the update performed by pynn_spinnaker's NeuronModels::IFCurr
+// when its cost was measured - **NOTE** this must not be changed
+class ReferenceIFCurr
+{
+public:
+  typedef CA2Adaptive::MutableState MutableState;
+  typedef CA2Adaptive::ImmutableState ImmutableState;
+
+  static inline bool Update(MutableState &mutableState, const ImmutableState &immutableState,
+                            S1615 excInput, S1615 inhInput, S1615 extCurrent)
+  {
+    if (mutableState.m_RefractoryTimer <= 0)
+    {
+      S1615 inputThisTimestep = excInput - inhInput + extCurrent + immutableState.m_I_Offset;
+      S1615 alpha = MulS1615(inputThisTimestep, immutableState.m_R_Membrane) + immutableState.m_V_Rest;
+      mutableState.m_V_Membrane = alpha - MulS1615(immutableState.m_ExpTC,
+                                                   alpha - mutableState.m_V_Membrane);
+      if (mutableState.m_V_Membrane >= immutableState.m_V_Threshold)
+      {
+        mutableState.m_V_Membrane = immutableState.m_V_Reset;
+        mutableState.m_RefractoryTimer = immutableState.m_T_Refractory;
+        return true;
+      }
+    }
+    else
+    {
+      mutableState.m_RefractoryTimer--;
+    }
+
+    return false;
+  }
+};
+
+//-----------------------------------------------------------------------------
+// ReferenceExp
+//-----------------------------------------------------------------------------
+// Copy of pynn_spinnaker's SynapseModels::Exp when its cost was measured
+class ReferenceExp
+{
+public:
+  struct MutableState
+  {
+    S1615 m_ISynExc;
+    S1615 m_ISynInh;
+  };
+
+  struct ImmutableState
+  {
+    U032 m_ExpTauSynExc;
+    S1615 m_InitExc;
+    U032 m_ExpTauSynInh;
+    S1615 m_InitInh;
+  };
+
+  static inline void ApplyInput(MutableState &mutableState, const ImmutableState &, S1615 input, unsigned int receptorType)
+  {
+    if(receptorType == 0)
+    {
+      mutableState.m_ISynExc += input;
+    }
+    else
+    {
+      mutableState.m_ISynInh += input;
+    }
+  }
+
+  static inline S1615 GetExcInput(const MutableState &mutableState, const ImmutableState &immutableState)
+  {
+    return MulS1615(mutableState.m_ISynExc, immutableState.m_InitExc);
+  }
+
+  static inline S1615 GetInhInput(const MutableState &mutableState, const ImmutableState &immutableState)
+  {
+    return MulS1615(mutableState.m_ISynInh, immutableState.m_InitInh);
+  }
+
+  static inline void Shape(MutableState &mutableState, const ImmutableState &immutableState)
+  {
+    mutableState.m_ISynExc = MulS1615U032(mutableState.m_ISynExc, immutableState.m_ExpTauSynExc);
+    mutableState.m_ISynInh = MulS1615U032(mutableState.m_ISynInh, immutableState.m_ExpTauSynInh);
+  }
+};
+
+//-----------------------------------------------------------------------------
+// ReferenceDualExp
+//-----------------------------------------------------------------------------
+// Copy of ExtraModels::DualExp when its cost was measured
+class ReferenceDualExp
+{
+public:
+  struct MutableState
+  {
+    S1615 m_ISynExc;
+    S1615 m_ISynExc2;
+    S1615 m_ISynInh;
+  };
+
+  struct ImmutableState
+  {
+    U032 m_ExpTauSynExc;
+    S1615 m_InitExc;
+    U032 m_ExpTauSynExc2;
+    S1615 m_InitExc2;
+    U032 m_ExpTauSynInh;
+    S1615 m_InitInh;
+  };
+
+  static inline void ApplyInput(MutableState &mutableState, const ImmutableState &, S1615 input, unsigned int receptorType)
+  {
+    if(receptorType == 0)
+    {
+      mutableState.m_ISynExc += input;
+    }
+    else if (receptorType == 1)
+    {
+      mutableState.m_ISynInh += input;
+    }
+    else
+    {
+      mutableState.m_ISynExc2 += input;
+    }
+  }
+
+  static inline S1615 GetExcInput(const MutableState &mutableState, const ImmutableState &immutableState)
+  {
+    return MulS1615(mutableState.m_ISynExc, immutableState.m_InitExc)
+      + MulS1615(mutableState.m_ISynExc2, immutableState.m_InitExc2);
+  }
+
+  static inline S1615 GetInhInput(const MutableState &mutableState, const ImmutableState &immutableState)
+  {
+    return MulS1615(mutableState.m_ISynInh, immutableState.m_InitInh);
+  }
+
+  static inline void Shape(MutableState &mutableState, const ImmutableState &immutableState)
+  {
+    mutableState.m_ISynExc = MulS1615U032(mutableState.m_ISynExc, immutableState.m_ExpTauSynExc);
+    mutableState.m_ISynInh = MulS1615U032(mutableState.m_ISynInh, immutableState.m_ExpTauSynInh);
+    mutableState.m_ISynExc2 = MulS1615U032(mutableState.m_ISynExc2, immutableState.m_ExpTauSynExc2);
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Counter
+//-----------------------------------------------------------------------------
+// Counts user-space instructions using perf events where available
+// (otherwise only elapsed time is measured)
+class Counter
+{
+public:
+  Counter() : m_FD(-1)
+  {
+#ifdef __linux__
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    m_FD = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+  }
+
+  ~Counter()
+  {
+#ifdef __linux__
+    if(m_FD >= 0)
+    {
+      close(m_FD);
+    }
+#endif
+  }
+
+  bool HasInstructions() const{ return (m_FD >= 0); }
+
+  void Start()
+  {
+#ifdef __linux__
+    if(m_FD >= 0)
+    {
+      ioctl(m_FD, PERF_EVENT_IOC_RESET, 0);
+      ioctl(m_FD, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+    m_Start = std::chrono::high_resolution_clock::now();
+  }
+
+  void Stop(double &nanoseconds, double &instructions)
+  {
+    const auto end = std::chrono::high_resolution_clock::now();
+    nanoseconds = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - m_Start).count();
+
+    instructions = 0.0;
+#ifdef __linux__
+    if(m_FD >= 0)
+    {
+      ioctl(m_FD, PERF_EVENT_IOC_DISABLE, 0);
+      long long count = 0;
+      if(read(m_FD, &count, sizeof(count)) == sizeof(count))
+      {
+        instructions = (double)count;
+      }
+    }
+#endif
+  }
+
+private:
+  int m_FD;
+  std::chrono::high_resolution_clock::time_point m_Start;
+};
+
+//-----------------------------------------------------------------------------
+// Cost
+//-----------------------------------------------------------------------------
+struct Cost
+{
+  double m_Nanoseconds;
+  double m_Instructions;
+  double m_SpikesPerUpdate;
+};
+
+//-----------------------------------------------------------------------------
+// Inputs
+//-----------------------------------------------------------------------------
+struct Inputs
+{
+  unsigned int m_NumTicks;
+  std::vector<S1615> m_Exc;
+  std::vector<S1615> m_Inh;
+};
+
+//-----------------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------------
+S1615 ToS1615(double value)
+{
+  return (S1615)std::round(value * 32768.0);
+}
+//-----------------------------------------------------------------------------
+U032 ToU032(double value)
+{
+  return (U032)std::min(std::round(value * 4294967296.0), 4294967295.0);
+}
+//-----------------------------------------------------------------------------
+Inputs BuildInputs(Mix mix, unsigned int numTicks)
+{
+  Inputs inputs;
+  inputs.m_NumTicks = numTicks;
+  inputs.m_Exc.resize(numTicks * NumNeurons, 0);
+  inputs.m_Inh.resize(numTicks * NumNeurons, 0);
+
+  // Idle neurons receive no input, spiking neurons receive noisy input
+  // every timestep which makes them fire irregularly and refractory
+  // neurons receive strong input so they spend most of their time refractory
+  // **NOTE** inputs arriving on random timesteps would make the host pay
+  // branch misprediction penalties which SpiNNaker's ARM968 doesn't have
+  if(mix != MixIdle)
+  {
+    std::mt19937 rng(mix);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    const double excAmplitude = (mix == MixSpiking) ? 2.0 : 20.0;
+    for(unsigned int i = 0; i < numTicks * NumNeurons; i++)
+    {
+      inputs.m_Exc[i] = ToS1615(excAmplitude * uniform(rng));
+      inputs.m_Inh[i] = ToS1615(0.2 * uniform(rng));
+    }
+  }
+  return inputs;
+}
+//-----------------------------------------------------------------------------
+CA2Adaptive::ImmutableState BuildNeuronImmutableState(Mix mix)
+{
+  CA2Adaptive::ImmutableState immutableState;
+  immutableState.m_V_Threshold = ToS1615(-50.0);
+  immutableState.m_V_Reset = ToS1615(-65.0);
+  immutableState.m_V_Rest = ToS1615(-65.0);
+  immutableState.m_I_Offset = 0;
+  immutableState.m_R_Membrane = ToS1615(20.0);
+  immutableState.m_ExpTC = ToS1615(std::exp(-Timestep / 20.0));
+  immutableState.m_T_Refractory = (mix == MixRefractory) ? 50 : 20;
+  immutableState.m_I_Alpha = ToS1615(0.1);
+  immutableState.m_ExpTauCa = ToS1615(std::exp(-Timestep / 50.0));
+  return immutableState;
+}
+//-----------------------------------------------------------------------------
+template<typename I>
+void SetExpSynapse(I &immutableState)
+{
+  immutableState.m_ExpTauSynExc = ToU032(std::exp(-Timestep / 5.0));
+  immutableState.m_InitExc = ToS1615((5.0 / Timestep) * (1.0 - std::exp(-Timestep / 5.0)));
+  immutableState.m_ExpTauSynInh = ToU032(std::exp(-Timestep / 5.0));
+  immutableState.m_InitInh = ToS1615((5.0 / Timestep) * (1.0 - std::exp(-Timestep / 5.0)));
+}
+//-----------------------------------------------------------------------------
+template<typename F>
+void Measure(Counter &counter, unsigned int numUpdates, F update, Cost &cost)
+{
+  unsigned int numSpikes = 0;
+  double nanoseconds;
+  double instructions;
+  counter.Start();
+  update(numSpikes);
+  counter.Stop(nanoseconds, instructions);
+
+  // Keep cheapest measurement to reduce the effect of noise
+  cost.m_Nanoseconds = std::min(cost.m_Nanoseconds, nanoseconds / (double)numUpdates);
+  cost.m_Instructions = std::min(cost.m_Instructions, instructions / (double)numUpdates);
+  cost.m_SpikesPerUpdate = (double)numSpikes / (double)numUpdates;
+}
+//-----------------------------------------------------------------------------
+template<typename N, typename I>
+void MeasureNeuron(Counter &counter, const I &immutableState, const Inputs &inputs, Cost &cost)
+{
+  // Give each neuron its own copy of the immutable state as
+  // pynn_spinnaker's neuron processor does for every model
+  std::vector<typename N::MutableState> mutableState(NumNeurons);
+  const std::vector<I> immutableStates(NumNeurons, immutableState);
+  Measure(counter, inputs.m_NumTicks * NumNeurons,
+    [&](unsigned int &numSpikes)
+    {
+      // Reset neurons to rest
+      for(auto &m : mutableState)
+      {
+        m = typename N::MutableState();
+        m.m_V_Membrane = immutableState.m_V_Rest;
+      }
+
+      const S1615 *exc = inputs.m_Exc.data();
+      const S1615 *inh = inputs.m_Inh.data();
+      for(unsigned int t = 0; t < inputs.m_NumTicks; t++)
+      {
+        for(unsigned int n = 0; n < NumNeurons; n++)
+        {
+          if(N::Update(mutableState[n], immutableStates[n],
+                       *exc++, *inh++, 0))
+          {
+            numSpikes++;
+          }
+        }
+      }
+    }, cost);
+}
+//-----------------------------------------------------------------------------
+template<typename S>
+void MeasureSynapse(Counter &counter, const typename S::ImmutableState &immutableState, const Inputs &inputs, Cost &cost)
+{
+  std::vector<typename S::MutableState> mutableState(NumNeurons);
+  volatile S1615 sink = 0;
+  Measure(counter, inputs.m_NumTicks * NumNeurons,
+    [&](unsigned int &)
+    {
+      for(auto &m : mutableState)
+      {
+        m = typename S::MutableState();
+      }
+
+      // Apply input, read the currents passed to the neuron and shape
+      const S1615 *exc = inputs.m_Exc.data();
+      const S1615 *inh = inputs.m_Inh.data();
+      S1615 total = 0;
+      for(unsigned int t = 0; t < inputs.m_NumTicks; t++)
+      {
+        for(unsigned int n = 0; n < NumNeurons; n++)
+        {
+          S::ApplyInput(mutableState[n], immutableState, *exc++, 0);
+          S::ApplyInput(mutableState[n], immutableState, *inh++, 1);
+          total += S::GetExcInput(mutableState[n], immutableState) - S::GetInhInput(mutableState[n], immutableState);
+          S::Shape(mutableState[n], immutableState);
+        }
+      }
+      sink = total;
+    }, cost);
+}
+//-----------------------------------------------------------------------------
+double GetHostCost(const Counter &counter, const Cost &cost)
+{
+  // Prefer instruction counts as they are unaffected by other processes
+  return counter.HasInstructions() ? cost.m_Instructions : cost.m_Nanoseconds;
+}
+}   // Anonymous namespace
+
+//-----------------------------------------------------------------------------
+// Entry point
+//-----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  // Parse arguments
+  const bool python = (argc > 1 && strcmp(argv[1], "--python") == 0);
+  const unsigned int numTicks = (argc > 2) ? (unsigned int)atoi(argv[2]) : 2000;
+
+  Counter counter;
+
+  // Neuron models measured and their costs under each mix
+  const std::vector<std::string> neuronNames = {"ReferenceIFCurr", "CA2Adaptive"};
+  const std::vector<std::string> synapseNames = {"ReferenceExp", "ReferenceDualExp"};
+  const Cost initialCost = {INFINITY, INFINITY, 0.0};
+  std::vector<std::vector<Cost>> neuronCosts(neuronNames.size(), std::vector<Cost>(MixMax, initialCost));
+  std::vector<std::vector<Cost>> synapseCosts(synapseNames.size(), std::vector<Cost>(MixMax, initialCost));
+
+  // Build inputs and parameters for each mix
+  // **NOTE** neurons are driven directly with currents
+  std::vector<Inputs> inputs;
+  std::vector<CA2Adaptive::ImmutableState> neuronImmutableState;
+  for(unsigned int m = 0; m < MixMax; m++)
+  {
+    inputs.push_back(BuildInputs((Mix)m, numTicks));
+    neuronImmutableState.push_back(BuildNeuronImmutableState((Mix)m));
+  }
+
+  ReferenceExp::ImmutableState expImmutableState;
+  SetExpSynapse(expImmutableState);
+  ReferenceDualExp::ImmutableState dualExpImmutableState;
+  SetExpSynapse(dualExpImmutableState);
+  dualExpImmutableState.m_ExpTauSynExc2 = dualExpImmutableState.m_ExpTauSynExc;
+  dualExpImmutableState.m_InitExc2 = dualExpImmutableState.m_InitExc;
+
+  // Repeatedly measure every model under every mix so that
+  // warm-up and changes in clock frequency affect them all equally
+  for(unsigned int r = 0; r < NumRepeats; r++)
+  {
+    for(unsigned int m = 0; m < MixMax; m++)
+    {
+      MeasureNeuron<ReferenceIFCurr>(counter, neuronImmutableState[m], inputs[m], neuronCosts[0][m]);
+      MeasureNeuron<CA2Adaptive>(counter, neuronImmutableState[m], inputs[m], neuronCosts[1][m]);
+
+      MeasureSynapse<ReferenceExp>(counter, expImmutableState, inputs[m], synapseCosts[0][m]);
+      MeasureSynapse<ReferenceDualExp>(counter, dualExpImmutableState, inputs[m], synapseCosts[1][m]);
+    }
+  }
+
+  // Convert the worst-case cost of each model to SpiNNaker cycles by scaling it
+  // by a factor fitted to the models of the same kind profiled on SpiNNaker
+  // **NOTE** ratios of host costs are far more stable than differences
+  auto getWorstHostCost =
+    [&](const std::vector<Cost> &costs)
+    {
+      double hostCost = 0.0;
+      for(const auto &c : costs)
+      {
+        hostCost = std::max(hostCost, GetHostCost(counter, c));
+      }
+      return hostCost;
+    };
+  auto getCycles =
+    [&](const std::vector<std::vector<Cost>> &costs, const std::vector<double> &profiledCycles)
+    {
+      // Fit the factor which minimises the squared relative
+      // error of the cycles predicted for the profiled models
+      double sumRatio = 0.0;
+      double sumRatioSquared = 0.0;
+      for(unsigned int i = 0; i < costs.size(); i++)
+      {
+        const double ratio = getWorstHostCost(costs[i]) / profiledCycles[i];
+        sumRatio += ratio;
+        sumRatioSquared += ratio * ratio;
+      }
+      const double cyclesPerHostCost = sumRatio / sumRatioSquared;
+
+      std::vector<double> cycles;
+      for(const auto &c : costs)
+      {
+        cycles.push_back(cyclesPerHostCost * getWorstHostCost(c));
+      }
+      return cycles;
+    };
+  const std::vector<double> neuronProfiledCycles = {ReferenceIFCurrCycles, CA2AdaptiveCycles};
+  const std::vector<double> synapseProfiledCycles = {ReferenceExpCycles, ReferenceDualExpCycles};
+  const std::vector<double> neuronCycles = getCycles(neuronCosts, neuronProfiledCycles);
+  const std::vector<double> synapseCycles = getCycles(synapseCosts, synapseProfiledCycles);
+
+  // Calculate error of predicted cycles relative to those profiled [%]
+  auto getError =
+    [](double cycles, double profiledCycles)
+    {
+      return 100.0 * (cycles - profiledCycles) / profiledCycles;
+    };
+
+  if(python)
+  {
+    printf("# Generated by runtime/benchmark/model_benchmark - do not edit\n");
+    printf("# Worst-case cost of each model in SpiNNaker CPU cycles per neuron per timestep\n");
+    printf("# Calibration error against costs profiled on SpiNNaker:\n");
+    auto printCalibration =
+      [&](const std::vector<std::string> &names, const std::vector<double> &cycles,
+          const std::vector<double> &profiledCycles)
+      {
+        for(unsigned int i = 0; i < names.size(); i++)
+        {
+          printf("#   %s: %.1f cycles, profiled %.0f (%+.1f%%)\n", names[i].c_str(),
+                 cycles[i], profiledCycles[i], getError(cycles[i], profiledCycles[i]));
+        }
+      };
+    printCalibration(neuronNames, neuronCycles, neuronProfiledCycles);
+    printCalibration(synapseNames, synapseCycles, synapseProfiledCycles);
+    printf("neuron_update_cpu_cycles = {\n");
+    for(unsigned int n = 1; n < neuronNames.size(); n++)
+    {
+      printf("    \"%s\": %u,\n", neuronNames[n].c_str(), (unsigned int)std::ceil(neuronCycles[n]));
+    }
+    printf("}\n\n");
+    printf("synapse_shape_cpu_cycles = {\n");
+    printf("    \"Exp\": %u,\n", (unsigned int)std::ceil(synapseCycles[0]));
+    printf("}\n");
+  }
+  else
+  {
+    printf("%-24s %10s %14s %14s %14s\n", "Model", "Mix", "Host ns", "Host instr", "Spikes/update");
+    auto printCosts =
+      [&](const std::vector<std::string> &names, const std::vector<std::vector<Cost>> &costs)
+      {
+        for(unsigned int i = 0; i < names.size(); i++)
+        {
+          for(unsigned int m = 0; m < MixMax; m++)
+          {
+            const Cost &cost = costs[i][m];
+            char instructions[32] = "-";
+            if(counter.HasInstructions())
+            {
+              snprintf(instructions, sizeof(instructions), "%.1f", cost.m_Instructions);
+            }
+            printf("%-24s %10s %14.2f %14s %14.4f\n", names[i].c_str(), MixNames[m],
+                   cost.m_Nanoseconds, instructions, cost.m_SpikesPerUpdate);
+          }
+        }
+      };
+    printCosts(neuronNames, neuronCosts);
+    printCosts(synapseNames, synapseCosts);
+
+    // Print cycles alongside the costs measured on SpiNNaker
+    auto printCycles =
+      [&](const std::vector<std::string> &names, const std::vector<double> &cycles,
+          const std::vector<double> &profiledCycles)
+      {
+        for(unsigned int i = 0; i < names.size(); i++)
+        {
+          printf("%-24s %14.1f %14.0f %13.1f%%\n", names[i].c_str(), cycles[i], profiledCycles[i],
+                 getError(cycles[i], profiledCycles[i]));
+        }
+      };
+    printf("\n%-24s %14s %14s %14s\n", "Model", "Cycles", "SpiNNaker", "Error");
+    printCycles(neuronNames, neuronCycles, neuronProfiledCycles);
+    printCycles(synapseNames, synapseCycles, synapseProfiledCycles);
+  }
+  return 0;
+}
@@ -21,6 +21,7 @@ public:
   enum RecordingChannel
   {
     RecordingChannelV,
+    RecordingChannelI_CA2,
     RecordingChannelMax,
   };
 
@@ -137,6 +138,9 @@ public:
       case RecordingChannelV:
         return mutableState.m_V_Membrane;
 
+      case RecordingChannelI_CA2:
+        return mutableState.m_I_CA2;
+
       default:
         LOG_PRINT(LOG_LEVEL_WARN, "Attempting to get data from non-existant recording channel %u", c);
         return 0;
@@ -1,7 +1,11 @@
 # Import classes
 from if_curr_dual_exp import IF_curr_dual_exp
+from multi_exp import IF_curr_multi_exp_2_2, IF_curr_multi_exp_3_3
 
 # Import globals
 from if_curr_dual_exp import (dual_exp_synapse_translations,
                               dual_exp_synapse_immutable_param_map,
-                              dual_exp_synapse_curr_mutable_param_map)
\ No newline at end of file
+                              dual_exp_synapse_curr_mutable_param_map)
+
+# Import functions
+from multi_exp import build_if_curr_multi_exp
@@ -1,5 +1,4 @@
 # Import modules
-from pynn_spinnaker.spinnaker import lazy_param_map
 from pynn_spinnaker.spinnaker import regions
 
 # Import classes
@@ -8,8 +7,11 @@ from pyNN.standardmodels.cells import StandardCellType
 # Import functions
 from copy import deepcopy
 from functools import partial
-from pyNN.standardmodels import build_translations
 from pynn_spinnaker.standardmodels.cells import calc_max_neurons_per_core
+from multi_exp import (calc_multi_exp_synapse_shape_cpu_cycles,
+                       get_multi_exp_synapse_translations,
+                       get_multi_exp_synapse_immutable_param_map,
+                       get_multi_exp_synapse_curr_mutable_param_map)
 
 # Import globals
 from pynn_spinnaker.standardmodels.cells import (if_curr_neuron_translations,
@@ -20,29 +22,16 @@ from pynn_spinnaker.standardmodels.cells import (if_curr_neuron_translations,
 # Synapse type translations
 # ----------------------------------------------------------------------------
 # Build translations from PyNN to SpiNNaker synapse model parameters
-dual_exp_synapse_translations = build_translations(
-    ("tau_syn_E",   "tau_syn_e"),
-    ("tau_syn_E2",   "tau_syn_e2"),
-    ("tau_syn_I",   "tau_syn_i"),
-)
+dual_exp_synapse_translations = get_multi_exp_synapse_translations(2, 1)
 
 # ----------------------------------------------------------------------------
 # Synapse shaping region maps
 # ----------------------------------------------------------------------------
-dual_exp_synapse_immutable_param_map = [
-    ("tau_syn_e", "u4", lazy_param_map.u032_exp_decay),
-    ("tau_syn_e", "i4", lazy_param_map.s1615_exp_init),
-    ("tau_syn_e2", "u4", lazy_param_map.u032_exp_decay),
-    ("tau_syn_e2", "i4", lazy_param_map.s1615_exp_init),
-    ("tau_syn_i", "u4", lazy_param_map.u032_exp_decay),
-    ("tau_syn_i", "i4", lazy_param_map.s1615_exp_init),
-]
+dual_exp_synapse_immutable_param_map = \
+    get_multi_exp_synapse_immutable_param_map(2, 1)
 
-dual_exp_synapse_curr_mutable_param_map = [
-    ("isyn_exc", "i4", lazy_param_map.s1615),
-    ("isyn_exc2", "i4", lazy_param_map.s1615),
-    ("isyn_inh", "i4", lazy_param_map.s1615),
-]
+dual_exp_synapse_curr_mutable_param_map = \
+    get_multi_exp_synapse_curr_mutable_param_map(2, 1)
 
 # ------------------------------------------------------------------------------
 # IF_curr_dual_exp
@@ -102,6 +91,6 @@ class IF_curr_dual_exp(StandardCellType):
     # --------------------------------------------------------------------------
     # How many of these neurons per core can
     # a SpiNNaker neuron processor handle
-    _calc_max_neurons_per_core = partial(calc_max_neurons_per_core,
-                                         neuron_update_cpu_cycles=143,
-                                         synapse_shape_cpu_cycles=47)
\ No newline at end of file
+    _calc_max_neurons_per_core = partial(
+        calc_max_neurons_per_core, neuron_update_cpu_cycles=143,
+        synapse_shape_cpu_cycles=calc_multi_exp_synapse_shape_cpu_cycles(2, 1))
\ No newline at end of file
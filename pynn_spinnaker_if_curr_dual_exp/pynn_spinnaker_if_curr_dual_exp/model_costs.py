@@ -0,0 +1,13 @@
+# Generated by runtime/benchmark/model_benchmark - do not edit
+# Cost of shaping MultiExp synapses with each number of excitatory and
+# inhibitory receptors in SpiNNaker CPU cycles per neuron per timestep
+# Calibration error against costs profiled on SpiNNaker:
+#   ReferenceExp: 30.1 cycles, profiled 28 (+7.5%)
+#   ReferenceDualExp: 42.9 cycles, profiled 47 (-8.8%)
+multi_exp_synapse_shape_cpu_cycles = {
+    (1, 1): 31,
+    (2, 1): 45,
+    (2, 2): 54,
+    (3, 3): 76,
+    (4, 4): 100,
+}
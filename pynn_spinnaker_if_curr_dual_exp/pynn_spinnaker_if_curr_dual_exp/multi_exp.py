@@ -0,0 +1,155 @@
+# Import modules
+from pynn_spinnaker.spinnaker import lazy_param_map
+from pynn_spinnaker.spinnaker import regions
+
+# Import classes
+from pyNN.standardmodels.cells import StandardCellType
+
+# Import functions
+from copy import deepcopy
+from functools import partial
+from math import ceil
+from pyNN.standardmodels import build_translations
+from pynn_spinnaker.standardmodels.cells import calc_max_neurons_per_core
+
+# Import globals
+from model_costs import multi_exp_synapse_shape_cpu_cycles
+from pynn_spinnaker.standardmodels.cells import (if_curr_neuron_translations,
+                                                 if_curr_neuron_immutable_param_map,
+                                                 if_curr_neuron_mutable_param_map)
+
+# ----------------------------------------------------------------------------
+# Functions
+# ----------------------------------------------------------------------------
+def _get_receptors(num_exc, num_inh):
+    # Build lists of receptor type, PyNN parameter suffix and state variable
+    # suffix for excitatory and inhibitory receptors
+    exc = [("excitatory", "E", "exc")]
+    exc.extend(("excitatory%u" % i, "E%u" % i, "exc%u" % i)
+               for i in range(2, num_exc + 1))
+    inh = [("inhibitory", "I", "inh")]
+    inh.extend(("inhibitory%u" % i, "I%u" % i, "inh%u" % i)
+               for i in range(2, num_inh + 1))
+
+    # Order receptors to match receptor type numbering in runtime/multi_exp.h
+    # **NOTE** the first excitatory and inhibitory receptors come first so
+    # the standard PyNN receptor types are always numbered 0 and 1
+    return [exc[0], inh[0]] + exc[1:] + inh[1:]
+
+
+def get_multi_exp_receptor_types(num_exc, num_inh):
+    return tuple(r[0] for r in _get_receptors(num_exc, num_inh))
+
+
+def get_multi_exp_synapse_translations(num_exc, num_inh):
+    # Build translations from PyNN to SpiNNaker synapse model parameters
+    return build_translations(
+        *[("tau_syn_" + p, "tau_syn_" + p.lower())
+          for _, p, _ in _get_receptors(num_exc, num_inh)])
+
+
+def get_multi_exp_synapse_immutable_param_map(num_exc, num_inh):
+    # Build map of where and how parameters need to be written into
+    # synapse shaping region - a decay and a scale for each receptor
+    param_map = []
+    for _, p, _ in _get_receptors(num_exc, num_inh):
+        param_map.append(("tau_syn_" + p.lower(), "u4",
+                          lazy_param_map.u032_exp_decay))
+        param_map.append(("tau_syn_" + p.lower(), "i4",
+                          lazy_param_map.s1615_exp_init))
+    return param_map
+
+
+def get_multi_exp_synapse_curr_mutable_param_map(num_exc, num_inh):
+    return [("isyn_" + s, "i4", lazy_param_map.s1615)
+            for _, _, s in _get_receptors(num_exc, num_inh)]
+
+
+def calc_multi_exp_synapse_shape_cpu_cycles(num_exc, num_inh):
+    # If cost of this synapse model has been measured by
+    # runtime/benchmark/model_benchmark, return it
+    receptors = (num_exc, num_inh)
+    if receptors in multi_exp_synapse_shape_cpu_cycles:
+        return multi_exp_synapse_shape_cpu_cycles[receptors]
+
+    # Otherwise, as shaping is unrolled so its cost is a fixed overhead plus
+    # the decay and scaling of each receptor's current, extrapolate linearly
+    # from the measured models with the fewest and most receptors
+    measured = sorted((sum(r), c) for r, c
+                      in multi_exp_synapse_shape_cpu_cycles.items())
+    (min_receptors, min_cycles), (max_receptors, max_cycles) = \
+        measured[0], measured[-1]
+    cycles_per_receptor = (float(max_cycles - min_cycles) /
+                           float(max_receptors - min_receptors))
+    return int(ceil(min_cycles + (cycles_per_receptor *
+                                  (num_exc + num_inh - min_receptors))))
+
+
+def build_if_curr_multi_exp(num_exc, num_inh):
+    """
+    Build a cell type with a leaky integrate and fire neuron and separate
+    decaying-exponential synaptic currents for `num_exc` excitatory and
+    `num_inh` inhibitory receptors. The runtime for each cell type is built
+    from its own build directory with ExtraModels::MultiExp<num_exc, num_inh>
+    as its synapse model and named after the class this returns.
+    """
+    receptors = _get_receptors(num_exc, num_inh)
+
+    default_parameters = {
+        "v_rest"     : -65.0,   # Resting membrane potential in mV.
+        "cm"         : 1.0,     # Capacity of the membrane in nF
+        "tau_m"      : 20.0,    # Membrane time constant in ms.
+        "tau_refrac" : 0.1,     # Duration of refractory period in ms.
+        "i_offset"   : 0.0,     # Offset current in nA
+        "v_reset"    : -65.0,   # Reset potential after a spike in mV.
+        "v_thresh"   : -50.0,   # Spike threshold in mV.
+    }
+    default_initial_values = {"v": -65.0}
+    units = {"v": "mV"}
+    for _, p, s in receptors:
+        # Decay time of synaptic current in ms.
+        default_parameters["tau_syn_" + p] = 5.0
+        default_initial_values["isyn_" + s] = 0.0
+        units["isyn_" + s] = "nA"
+
+    translations = deepcopy(if_curr_neuron_translations)
+    translations.update(get_multi_exp_synapse_translations(num_exc, num_inh))
+
+    name = "IF_curr_multi_exp_%u_%u" % (num_exc, num_inh)
+    return type(name, (StandardCellType,), {
+        "__doc__": "Leaky integrate and fire model with fixed threshold and "
+                   "separate decaying-exponential post-synaptic currents for "
+                   "%u excitatory and %u inhibitory receptors." % (num_exc,
+                                                                   num_inh),
+        "default_parameters": default_parameters,
+        "recordable": ["spikes", "v"],
+        "conductance_based": False,
+        "default_initial_values": default_initial_values,
+        "units": units,
+        "receptor_types": get_multi_exp_receptor_types(num_exc, num_inh),
+        "translations": translations,
+
+        "_neuron_region_class": regions.Neuron,
+        "_directly_connectable": False,
+
+        "_neuron_immutable_param_map": if_curr_neuron_immutable_param_map,
+        "_neuron_mutable_param_map": if_curr_neuron_mutable_param_map,
+
+        "_synapse_immutable_param_map":
+            get_multi_exp_synapse_immutable_param_map(num_exc, num_inh),
+        "_synapse_mutable_param_map":
+            get_multi_exp_synapse_curr_mutable_param_map(num_exc, num_inh),
+
+        "_calc_max_neurons_per_core": partial(
+            calc_max_neurons_per_core, neuron_update_cpu_cycles=143,
+            synapse_shape_cpu_cycles=calc_multi_exp_synapse_shape_cpu_cycles(
+                num_exc, num_inh)),
+    })
+
+# ------------------------------------------------------------------------------
+# Cell types
+# ------------------------------------------------------------------------------
+# **NOTE** each of these requires a build directory in runtime
+# e.g. AMPA, NMDA-like slow excitation, GABA-A and GABA-B
+IF_curr_multi_exp_2_2 = build_if_curr_multi_exp(2, 2)
+IF_curr_multi_exp_3_3 = build_if_curr_multi_exp(3, 3)
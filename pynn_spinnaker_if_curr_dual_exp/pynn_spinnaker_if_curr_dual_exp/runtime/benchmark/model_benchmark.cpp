@@ -0,0 +1,494 @@
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Rig CPP common includes
+#include "rig_cpp_common/fixed_point_number.h"
+#include "rig_cpp_common/log.h"
+
+// Extra model includes
+// **NOTE** these rely on logging having already been included
+#include "../dual_exp.h"
+#include "../multi_exp.h"
+
+// Namespaces
+using namespace Common::FixedPointNumber;
+using namespace ExtraModels;
+
+//-----------------------------------------------------------------------------
+// Anonymous namespace
+//-----------------------------------------------------------------------------
+namespace
+{
+//-----------------------------------------------------------------------------
+// Constants
+//-----------------------------------------------------------------------------
+// Number of neurons whose synapses are shaped each simulated timestep
+const unsigned int NumNeurons = 256;
+
+// Number of times each measurement is repeated (the cheapest is used)
+const unsigned int NumRepeats = 25;
+
+// Simulation timestep [ms]
+const double Timestep = 0.1;
+
+// Costs of pynn_spinnaker's SynapseModels::Exp and the original DualExp,
+// measured on SpiNNaker with the profiler, to which the conversion
+// of host costs into SpiNNaker CPU cycles is fitted
+const double ReferenceExpCycles = 28.0;
+const double ReferenceDualExpCycles = 47.0;
+
+//-----------------------------------------------------------------------------
+// ReferenceExp
+//-----------------------------------------------------------------------------
+// Copy of pynn_spinnaker's SynapseModels::Exp when its cost was measured
+// **NOTE** this must not be changed
+class ReferenceExp
+{
+public:
+  struct MutableState
+  {
+    S1615 m_ISynExc;
+    S1615 m_ISynInh;
+  };
+
+  struct ImmutableState
+  {
+    U032 m_ExpTauSynExc;
+    S1615 m_InitExc;
+    U032 m_ExpTauSynInh;
+    S1615 m_InitInh;
+  };
+
+  static inline void ApplyInput(MutableState &mutableState, const ImmutableState &, S1615 input, unsigned int receptorType)
+  {
+    if(receptorType == 0)
+    {
+      mutableState.m_ISynExc += input;
+    }
+    else
+    {
+      mutableState.m_ISynInh += input;
+    }
+  }
+
+  static inline S1615 GetExcInput(const MutableState &mutableState, const ImmutableState &immutableState)
+  {
+    return MulS1615(mutableState.m_ISynExc, immutableState.m_InitExc);
+  }
+
+  static inline S1615 GetInhInput(const MutableState &mutableState, const ImmutableState &immutableState)
+  {
+    return MulS1615(mutableState.m_ISynInh, immutableState.m_InitInh);
+  }
+
+  static inline void Shape(MutableState &mutableState, const ImmutableState &immutableState)
+  {
+    mutableState.m_ISynExc = MulS1615U032(mutableState.m_ISynExc, immutableState.m_ExpTauSynExc);
+    mutableState.m_ISynInh = MulS1615U032(mutableState.m_ISynInh, immutableState.m_ExpTauSynInh);
+  }
+};
+
+//-----------------------------------------------------------------------------
+// ReferenceDualExp
+//-----------------------------------------------------------------------------
+// Copy of the original DualExp when its cost was measured
+// **NOTE** this must not be changed
+class ReferenceDualExp
+{
+public:
+  struct MutableState
+  {
+    S1615 m_ISynExc;
+    S1615 m_ISynExc2;
+    S1615 m_ISynInh;
+  };
+
+  struct ImmutableState
+  {
+    U032 m_ExpTauSynExc;
+    S1615 m_InitExc;
+    U032 m_ExpTauSynExc2;
+    S1615 m_InitExc2;
+    U032 m_ExpTauSynInh;
+    S1615 m_InitInh;
+  };
+
+  static inline void ApplyInput(MutableState &mutableState, const ImmutableState &, S1615 input, unsigned int receptorType)
+  {
+    if(receptorType == 0)
+    {
+      mutableState.m_ISynExc += input;
+    }
+    else if (receptorType == 1)
+    {
+      mutableState.m_ISynInh += input;
+    }
+    else
+    {
+      mutableState.m_ISynExc2 += input;
+    }
+  }
+
+  static inline S1615 GetExcInput(const MutableState &mutableState, const ImmutableState &immutableState)
+  {
+    return MulS1615(mutableState.m_ISynExc, immutableState.m_InitExc)
+      + MulS1615(mutableState.m_ISynExc2, immutableState.m_InitExc2);
+  }
+
+  static inline S1615 GetInhInput(const MutableState &mutableState, const ImmutableState &immutableState)
+  {
+    return MulS1615(mutableState.m_ISynInh, immutableState.m_InitInh);
+  }
+
+  static inline void Shape(MutableState &mutableState, const ImmutableState &immutableState)
+  {
+    mutableState.m_ISynExc = MulS1615U032(mutableState.m_ISynExc, immutableState.m_ExpTauSynExc);
+    mutableState.m_ISynInh = MulS1615U032(mutableState.m_ISynInh, immutableState.m_ExpTauSynInh);
+    mutableState.m_ISynExc2 = MulS1615U032(mutableState.m_ISynExc2, immutableState.m_ExpTauSynExc2);
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Counter
+//-----------------------------------------------------------------------------
+// Counts user-space instructions using perf events where available
+// (otherwise only elapsed time is measured)
+class Counter
+{
+public:
+  Counter() : m_FD(-1)
+  {
+#ifdef __linux__
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    m_FD = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+  }
+
+  ~Counter()
+  {
+#ifdef __linux__
+    if(m_FD >= 0)
+    {
+      close(m_FD);
+    }
+#endif
+  }
+
+  bool HasInstructions() const{ return (m_FD >= 0); }
+
+  void Start()
+  {
+#ifdef __linux__
+    if(m_FD >= 0)
+    {
+      ioctl(m_FD, PERF_EVENT_IOC_RESET, 0);
+      ioctl(m_FD, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+    m_Start = std::chrono::high_resolution_clock::now();
+  }
+
+  void Stop(double &nanoseconds, double &instructions)
+  {
+    const auto end = std::chrono::high_resolution_clock::now();
+    nanoseconds = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - m_Start).count();
+
+    instructions = 0.0;
+#ifdef __linux__
+    if(m_FD >= 0)
+    {
+      ioctl(m_FD, PERF_EVENT_IOC_DISABLE, 0);
+      long long count = 0;
+      if(read(m_FD, &count, sizeof(count)) == sizeof(count))
+      {
+        instructions = (double)count;
+      }
+    }
+#endif
+  }
+
+private:
+  int m_FD;
+  std::chrono::high_resolution_clock::time_point m_Start;
+};
+
+//-----------------------------------------------------------------------------
+// Variables
+//-----------------------------------------------------------------------------
+// Result of measured code - prevents compiler optimising it away
+volatile S1615 g_Sink = 0;
+
+//-----------------------------------------------------------------------------
+// Cost
+//-----------------------------------------------------------------------------
+struct Cost
+{
+  double m_Nanoseconds;
+  double m_Instructions;
+};
+
+//-----------------------------------------------------------------------------
+// Inputs
+//-----------------------------------------------------------------------------
+struct Inputs
+{
+  unsigned int m_NumTicks;
+  std::vector<S1615> m_Exc;
+  std::vector<S1615> m_Inh;
+};
+
+//-----------------------------------------------------------------------------
+// Model
+//-----------------------------------------------------------------------------
+// Synapse model being measured and its cost
+struct Model
+{
+  std::string m_Name;
+  unsigned int m_NumExc;
+  unsigned int m_NumInh;
+  void (*m_Measure)(Counter &counter, const Inputs &inputs, Cost &cost);
+  Cost m_Cost;
+};
+
+//-----------------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------------
+S1615 ToS1615(double value)
+{
+  return (S1615)std::round(value * 32768.0);
+}
+//-----------------------------------------------------------------------------
+U032 ToU032(double value)
+{
+  return (U032)std::min(std::round(value * 4294967296.0), 4294967295.0);
+}
+//-----------------------------------------------------------------------------
+Inputs BuildInputs(unsigned int numTicks)
+{
+  // Every synapse receives input every timestep so that, as on
+  // SpiNNaker, the host pays no branch misprediction penalties
+  Inputs inputs;
+  inputs.m_NumTicks = numTicks;
+  inputs.m_Exc.resize(numTicks * NumNeurons);
+  inputs.m_Inh.resize(numTicks * NumNeurons);
+
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  for(unsigned int i = 0; i < numTicks * NumNeurons; i++)
+  {
+    inputs.m_Exc[i] = ToS1615(2.0 * uniform(rng));
+    inputs.m_Inh[i] = ToS1615(0.2 * uniform(rng));
+  }
+  return inputs;
+}
+//-----------------------------------------------------------------------------
+double GetInit(double tauSyn)
+{
+  return (tauSyn / Timestep) * (1.0 - std::exp(-Timestep / tauSyn));
+}
+//-----------------------------------------------------------------------------
+ReferenceExp::ImmutableState BuildImmutableState(const ReferenceExp *)
+{
+  ReferenceExp::ImmutableState immutableState;
+  immutableState.m_ExpTauSynExc = ToU032(std::exp(-Timestep / 5.0));
+  immutableState.m_InitExc = ToS1615(GetInit(5.0));
+  immutableState.m_ExpTauSynInh = ToU032(std::exp(-Timestep / 5.0));
+  immutableState.m_InitInh = ToS1615(GetInit(5.0));
+  return immutableState;
+}
+//-----------------------------------------------------------------------------
+ReferenceDualExp::ImmutableState BuildImmutableState(const ReferenceDualExp *)
+{
+  ReferenceDualExp::ImmutableState immutableState;
+  immutableState.m_ExpTauSynExc = ToU032(std::exp(-Timestep / 5.0));
+  immutableState.m_InitExc = ToS1615(GetInit(5.0));
+  immutableState.m_ExpTauSynExc2 = ToU032(std::exp(-Timestep / 5.0));
+  immutableState.m_InitExc2 = ToS1615(GetInit(5.0));
+  immutableState.m_ExpTauSynInh = ToU032(std::exp(-Timestep / 5.0));
+  immutableState.m_InitInh = ToS1615(GetInit(5.0));
+  return immutableState;
+}
+//-----------------------------------------------------------------------------
+template<unsigned int NumExc, unsigned int NumInh>
+typename MultiExp<NumExc, NumInh>::ImmutableState BuildImmutableState(const MultiExp<NumExc, NumInh> *)
+{
+  typename MultiExp<NumExc, NumInh>::ImmutableState immutableState;
+  for(auto &r : immutableState.m_Receptors)
+  {
+    r.m_ExpTauSyn = ToU032(std::exp(-Timestep / 5.0));
+    r.m_Init = ToS1615(GetInit(5.0));
+  }
+  return immutableState;
+}
+//-----------------------------------------------------------------------------
+template<typename S>
+void MeasureSynapse(Counter &counter, const Inputs &inputs, Cost &cost)
+{
+  const typename S::ImmutableState immutableState = BuildImmutableState((const S*)nullptr);
+
+  // Give each neuron a copy of the immutable state as on SpiNNaker
+  std::vector<typename S::MutableState> mutableState(NumNeurons);
+  const std::vector<typename S::ImmutableState> immutableStates(NumNeurons, immutableState);
+
+  double nanoseconds;
+  double instructions;
+  counter.Start();
+  {
+    // Apply input, read the currents passed to the neuron and shape
+    const S1615 *exc = inputs.m_Exc.data();
+    const S1615 *inh = inputs.m_Inh.data();
+    S1615 total = 0;
+    for(unsigned int t = 0; t < inputs.m_NumTicks; t++)
+    {
+      for(unsigned int n = 0; n < NumNeurons; n++)
+      {
+        S::ApplyInput(mutableState[n], immutableStates[n], *exc++, 0);
+        S::ApplyInput(mutableState[n], immutableStates[n], *inh++, 1);
+        total += S::GetExcInput(mutableState[n], immutableStates[n]) - S::GetInhInput(mutableState[n], immutableStates[n]);
+        S::Shape(mutableState[n], immutableStates[n]);
+      }
+    }
+    g_Sink = total;
+  }
+  counter.Stop(nanoseconds, instructions);
+
+  // Keep cheapest measurement to reduce the effect of noise
+  const double numUpdates = (double)(inputs.m_NumTicks * NumNeurons);
+  cost.m_Nanoseconds = std::min(cost.m_Nanoseconds, nanoseconds / numUpdates);
+  cost.m_Instructions = std::min(cost.m_Instructions, instructions / numUpdates);
+}
+//-----------------------------------------------------------------------------
+double GetHostCost(const Counter &counter, const Cost &cost)
+{
+  // Prefer instruction counts as they are unaffected by other processes
+  return counter.HasInstructions() ? cost.m_Instructions : cost.m_Nanoseconds;
+}
+}   // Anonymous namespace
+
+//-----------------------------------------------------------------------------
+// Entry point
+//-----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  // Parse arguments
+  const bool python = (argc > 1 && strcmp(argv[1], "--python") == 0);
+  const unsigned int numTicks = (argc > 2) ? (unsigned int)atoi(argv[2]) : 2000;
+
+  Counter counter;
+
+  // Synapse models measured - the two reference models come first
+  const Cost initialCost = {INFINITY, INFINITY};
+  std::vector<Model> models = {
+    {"ReferenceExp", 1, 1, &MeasureSynapse<ReferenceExp>, initialCost},
+    {"ReferenceDualExp", 2, 1, &MeasureSynapse<ReferenceDualExp>, initialCost},
+    {"MultiExp<1, 1>", 1, 1, &MeasureSynapse<MultiExp<1, 1>>, initialCost},
+    {"DualExp", 2, 1, &MeasureSynapse<DualExp>, initialCost},
+    {"MultiExp<2, 2>", 2, 2, &MeasureSynapse<MultiExp<2, 2>>, initialCost},
+    {"MultiExp<3, 3>", 3, 3, &MeasureSynapse<MultiExp<3, 3>>, initialCost},
+    {"MultiExp<4, 4>", 4, 4, &MeasureSynapse<MultiExp<4, 4>>, initialCost},
+  };
+
+  // Repeatedly measure every model so that warm-up
+  // and changes in clock frequency affect them all equally
+  const Inputs inputs = BuildInputs(numTicks);
+  for(unsigned int r = 0; r < NumRepeats; r++)
+  {
+    for(auto &m : models)
+    {
+      m.m_Measure(counter, inputs, m.m_Cost);
+    }
+  }
+
+  // Convert the cost of each model to SpiNNaker cycles by scaling it by a
+  // factor fitted to the reference models profiled on SpiNNaker, chosen to
+  // minimise the squared relative error of the cycles predicted for them
+  // **NOTE** ratios of host costs are far more stable than differences
+  const double profiledCycles[2] = {ReferenceExpCycles, ReferenceDualExpCycles};
+  double sumRatio = 0.0;
+  double sumRatioSquared = 0.0;
+  for(unsigned int i = 0; i < 2; i++)
+  {
+    const double ratio = GetHostCost(counter, models[i].m_Cost) / profiledCycles[i];
+    sumRatio += ratio;
+    sumRatioSquared += ratio * ratio;
+  }
+  const double cyclesPerHostCost = sumRatio / sumRatioSquared;
+
+  std::vector<double> cycles;
+  for(const auto &m : models)
+  {
+    cycles.push_back(cyclesPerHostCost * GetHostCost(counter, m.m_Cost));
+  }
+
+  // Calculate error of cycles predicted for reference models relative to those profiled [%]
+  auto getError =
+    [&](unsigned int i)
+    {
+      return 100.0 * (cycles[i] - profiledCycles[i]) / profiledCycles[i];
+    };
+
+  if(python)
+  {
+    printf("# Generated by runtime/benchmark/model_benchmark - do not edit\n");
+    printf("# Cost of shaping MultiExp synapses with each number of excitatory and\n");
+    printf("# inhibitory receptors in SpiNNaker CPU cycles per neuron per timestep\n");
+    printf("# Calibration error against costs profiled on SpiNNaker:\n");
+    for(unsigned int i = 0; i < 2; i++)
+    {
+      printf("#   %s: %.1f cycles, profiled %.0f (%+.1f%%)\n", models[i].m_Name.c_str(),
+             cycles[i], profiledCycles[i], getError(i));
+    }
+    printf("multi_exp_synapse_shape_cpu_cycles = {\n");
+    for(unsigned int i = 2; i < models.size(); i++)
+    {
+      printf("    (%u, %u): %u,\n", models[i].m_NumExc, models[i].m_NumInh,
+             (unsigned int)std::ceil(cycles[i]));
+    }
+    printf("}\n");
+  }
+  else
+  {
+    printf("%-24s %14s %14s %14s %14s %14s\n", "Model", "Host ns", "Host instr", "Cycles", "SpiNNaker", "Error");
+    for(unsigned int i = 0; i < models.size(); i++)
+    {
+      char instructions[32] = "-";
+      if(counter.HasInstructions())
+      {
+        snprintf(instructions, sizeof(instructions), "%.1f", models[i].m_Cost.m_Instructions);
+      }
+      char measured[32] = "-";
+      char error[32] = "-";
+      if(i < 2)
+      {
+        snprintf(measured, sizeof(measured), "%.0f", profiledCycles[i]);
+        snprintf(error, sizeof(error), "%+.1f%%", getError(i));
+      }
+      printf("%-24s %14.2f %14s %14.1f %14s %14s\n", models[i].m_Name.c_str(), models[i].m_Cost.m_Nanoseconds,
+             instructions, cycles[i], measured, error);
+    }
+  }
+  return 0;
+}
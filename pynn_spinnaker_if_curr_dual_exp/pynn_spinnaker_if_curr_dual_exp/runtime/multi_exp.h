@@ -0,0 +1,161 @@
+#pragma once
+
+// Rig CPP common includes
+#include "rig_cpp_common/fixed_point_number.h"
+#include "rig_cpp_common/spinnaker.h"
+
+// Namespaces
+using namespace Common::FixedPointNumber;
+
+//-----------------------------------------------------------------------------
+// ExtraModels::MultiExp
+//-----------------------------------------------------------------------------
+// Exponentially-decaying synaptic currents for NumExc excitatory and NumInh
+// inhibitory receptors. Receptor types are numbered so the standard PyNN
+// "excitatory" and "inhibitory" receptors remain 0 and 1:
+//   0                             excitatory
+//   1                             inhibitory
+//   2 to NumExc                   excitatory2 to excitatory<NumExc>
+//   NumExc + 1 to NumReceptors-1  inhibitory2 to inhibitory<NumInh>
+// Input is applied by indexing the receptor arrays directly and, as the
+// number of receptors is known at compile time, shaping and summing currents
+// are unrolled so the cost per neuron is fixed and free of branches
+namespace ExtraModels
+{
+template<unsigned int NumExc, unsigned int NumInh>
+class MultiExp
+{
+public:
+  //-----------------------------------------------------------------------------
+  // Constants
+  //-----------------------------------------------------------------------------
+  static const unsigned int NumReceptors = NumExc + NumInh;
+
+  //-----------------------------------------------------------------------------
+  // MutableState
+  //-----------------------------------------------------------------------------
+  struct MutableState
+  {
+    // Input current of each receptor
+    S1615 m_ISyn[NumReceptors];
+  };
+
+  //-----------------------------------------------------------------------------
+  // ImmutableState
+  //-----------------------------------------------------------------------------
+  struct ImmutableState
+  {
+    struct Receptor
+    {
+      // Decay constant
+      U032 m_ExpTauSyn;
+
+      // Scale
+      S1615 m_Init;
+    };
+
+    Receptor m_Receptors[NumReceptors];
+  };
+
+  //-----------------------------------------------------------------------------
+  // Static methods
+  //-----------------------------------------------------------------------------
+  static inline void ApplyInput(MutableState &mutableState, const ImmutableState &, S1615 input, unsigned int receptorType)
+  {
+    mutableState.m_ISyn[receptorType] += input;
+  }
+
+  static inline S1615 GetExcInput(const MutableState &mutableState, const ImmutableState &immutableState)
+  {
+    return GetScaledCurrent<0>(mutableState, immutableState)
+      + SumScaledCurrents<2, NumExc + 1>(mutableState, immutableState);
+  }
+
+  static inline S1615 GetInhInput(const MutableState &mutableState, const ImmutableState &immutableState)
+  {
+    return GetScaledCurrent<1>(mutableState, immutableState)
+      + SumScaledCurrents<NumExc + 1, NumReceptors>(mutableState, immutableState);
+  }
+
+  static inline void Shape(MutableState &mutableState, const ImmutableState &immutableState)
+  {
+    DecayCurrents<0, NumReceptors>(mutableState, immutableState);
+  }
+
+  static void Print(char *stream, const MutableState &mutableState, const ImmutableState &immutableState)
+  {
+    io_printf(stream, "\tMutable state:\n");
+    for(unsigned int r = 0; r < NumReceptors; r++)
+    {
+      io_printf(stream, "\t\tISyn[%u]          = %11.4k [nA]\n", r, mutableState.m_ISyn[r]);
+    }
+
+    io_printf(stream, "\tImmutable state:\n");
+    for(unsigned int r = 0; r < NumReceptors; r++)
+    {
+      io_printf(stream, "\t\tExpTauSyn[%u]     = %11.4k\n", r, (S1615)(immutableState.m_Receptors[r].m_ExpTauSyn >> 17));
+      io_printf(stream, "\t\tInit[%u]          = %11.4k [nA]\n", r, immutableState.m_Receptors[r].m_Init);
+    }
+  }
+
+private:
+  //-----------------------------------------------------------------------------
+  // RangeEmpty
+  //-----------------------------------------------------------------------------
+  // Tag used to select between recursive and terminating overloads when
+  // unrolling operations over a range of receptors at compile time
+  template<bool Empty>
+  struct RangeEmpty
+  {
+  };
+
+  //-----------------------------------------------------------------------------
+  // Private static methods
+  //-----------------------------------------------------------------------------
+  template<unsigned int R>
+  static inline S1615 GetScaledCurrent(const MutableState &mutableState, const ImmutableState &immutableState)
+  {
+    return MulS1615(mutableState.m_ISyn[R], immutableState.m_Receptors[R].m_Init);
+  }
+
+  template<unsigned int Begin, unsigned int End>
+  static inline S1615 SumScaledCurrents(const MutableState &mutableState, const ImmutableState &immutableState)
+  {
+    return SumScaledCurrents<Begin, End>(mutableState, immutableState, RangeEmpty<(Begin >= End)>());
+  }
+
+  template<unsigned int Begin, unsigned int End>
+  static inline S1615 SumScaledCurrents(const MutableState &mutableState, const ImmutableState &immutableState,
+                                        RangeEmpty<false>)
+  {
+    return GetScaledCurrent<Begin>(mutableState, immutableState)
+      + SumScaledCurrents<Begin + 1, End>(mutableState, immutableState);
+  }
+
+  template<unsigned int Begin, unsigned int End>
+  static inline S1615 SumScaledCurrents(const MutableState &, const ImmutableState &, RangeEmpty<true>)
+  {
+    return 0;
+  }
+
+  template<unsigned int Begin, unsigned int End>
+  static inline void DecayCurrents(MutableState &mutableState, const ImmutableState &immutableState)
+  {
+    DecayCurrents<Begin, End>(mutableState, immutableState, RangeEmpty<(Begin >= End)>());
+  }
+
+  template<unsigned int Begin, unsigned int End>
+  static inline void DecayCurrents(MutableState &mutableState, const ImmutableState &immutableState,
+                                   RangeEmpty<false>)
+  {
+    mutableState.m_ISyn[Begin] = MulS1615U032(mutableState.m_ISyn[Begin],
+                                               immutableState.m_Receptors[Begin].m_ExpTauSyn);
+    DecayCurrents<Begin + 1, End>(mutableState, immutableState);
+  }
+
+  template<unsigned int Begin, unsigned int End>
+  static inline void DecayCurrents(MutableState &, const ImmutableState &, RangeEmpty<true>)
+  {
+  }
+};
+} // ExtraModels
\ No newline at end of file
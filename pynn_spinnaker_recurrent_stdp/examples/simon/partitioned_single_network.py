@@ -35,6 +35,8 @@ p.setup(timestep=timeStep, min_delay = timeStep, max_delay = timeStep * 14, **se
 
 nSourceNeurons = 3200 # number of input (excitatory) neurons
 nExcitNeurons  = 3200 # number of excitatory neurons in the recurrent memory
+# **NOTE** RecurrentSTDP rows are still DMAed whole into a fixed size buffer
+# so, with 3200 sources, projections still need partitioning by hand
 sourcePartitionSz = 50 # Number of spike sources in a single projection
 numPartitions = 1.0 * nSourceNeurons / sourcePartitionSz
 if numPartitions != int(numPartitions):
@@ -214,7 +216,8 @@ for i in range(numPartitions):
         p.FixedProbabilityConnector(p_connect=connProb),
         r.RecurrentSTDPSynapse(w_min=0.0, w_max=16.0, A_plus=0.3, A_minus=0.3,
             accumulator_increase=1.0 / 2.0, accumulator_decrease=1.0 / 6.0,
-            lambda_pre=10.0, lambda_post=10.0, tau_a=300.0, weight=baseline_excit_weight, delay=1.0),
+            lambda_pre=10.0, lambda_post=10.0, tau_a=300.0, weight=baseline_excit_weight, delay=1.0,
+            plasticity_off_start=recordStartTime, plasticity_off_end=runTime),
         receptor_type='excitatory'))
 
 #plastic_connection = p.Projection(source_pop, excit_pop,
@@ -1,2 +1,10 @@
 # Import classes
-from recurrent_stdp import RecurrentSTDPSynapse
\ No newline at end of file
+from recurrent_stdp import (RecurrentSTDPSynapse, RecurrentSTDPWideSynapse,
+                            RecurrentSTDPDeepSynapse, RecurrentSTDPCompactSynapse,
+                            RecurrentSTDPBakedSynapse, RecurrentSTDPCompressedSynapse)
+from matrix_reader import SubMatrix
+
+# Import functions
+from profiler import decode_profile, get_phase_histograms
+from matrix_reader import (read_synapses, read_weights, read_row_states,
+                           write_row_states, save_row_states, load_row_states)
@@ -0,0 +1,114 @@
+# Import modules
+import errno
+import hashlib
+import lazyarray as la
+import numpy as np
+import os
+import tempfile
+
+# Import functions
+from functools import wraps
+
+# Import globals
+from pynn_spinnaker.simulator import state
+
+# Directory in which generated lookup tables are cached between runs.
+# If None, lookup tables are only cached in memory for the lifetime
+# of the process. Defaults to the PYNN_SPINNAKER_LUT_CACHE_DIR
+# environment variable if this is set
+cache_dir = os.environ.get("PYNN_SPINNAKER_LUT_CACHE_DIR")
+
+# Version of the lookup table generators, included in every key so tables
+# cached on disk by an earlier version are never reused. **NOTE** this must
+# be incremented whenever a cached generator (including those wrapped from
+# pynn_spinnaker's lazy_param_map) or the table format changes
+LUT_FORMAT_VERSION = 1
+
+# Lookup tables generated by this process indexed by key
+_memory_cache = {}
+
+# Types of keyword argument which contribute to a lookup table's key
+_key_types = (bool, int, float, str, tuple)
+
+# ------------------------------------------------------------------------------
+# Functions
+# ------------------------------------------------------------------------------
+def clear():
+    """
+    Empty the in-memory lookup table cache. The on-disk
+    cache can be cleared by deleting the contents of `cache_dir`.
+    """
+    _memory_cache.clear()
+
+
+def cached_lut(generator):
+    """
+    Wrap a lazy parameter map function which generates a lookup table from
+    a homogeneous parameter so tables generated from the same value,
+    simulation timestep, keyword arguments (i.e. number of entries and
+    time shift) and LUT_FORMAT_VERSION are only generated once and are
+    reused across projections and, if `cache_dir` is set, across runs.
+    """
+    name = "%s.%s" % (generator.__module__, generator.__name__)
+
+    @wraps(generator)
+    def wrapper(values, **kwargs):
+        # Assert that values are homogeneous
+        assert values.is_homogeneous
+        value = values.evaluate(simplify=True)
+
+        # Build key from everything that determines the table's contents
+        key_kwargs = sorted((k, v) for k, v in kwargs.items()
+                            if isinstance(v, _key_types))
+        key = hashlib.sha1(repr((LUT_FORMAT_VERSION, name, float(value),
+                                 float(state.dt), key_kwargs)).encode("utf-8")).hexdigest()
+
+        # If table has been generated by this process, return it
+        lut = _memory_cache.get(key)
+        if lut is not None:
+            return lut
+
+        # Otherwise, if table has been cached on disk, load it
+        path = (None if cache_dir is None
+                else os.path.join(cache_dir, key + ".npy"))
+        if path is not None and os.path.exists(path):
+            lut = np.load(path)
+        # Otherwise, generate table
+        else:
+            lut = generator(values, **kwargs)
+            if isinstance(lut, la.larray):
+                lut = lut.evaluate()
+            lut = np.asarray(lut)
+
+            # If disk cache is enabled, write table to it via
+            # temporary file so concurrent runs never see partial tables
+            if path is not None:
+                _write(path, lut)
+
+        # **NOTE** the same table is returned to every caller so
+        # make it read-only to prevent it being modified in place
+        lut.flags.writeable = False
+        _memory_cache[key] = lut
+        return lut
+
+    return wrapper
+
+
+def _write(path, lut):
+    # Create cache directory if it doesn't already exist
+    try:
+        os.makedirs(cache_dir)
+    except OSError as e:
+        if e.errno != errno.EEXIST:
+            raise
+
+    fd, temp_path = tempfile.mkstemp(suffix=".npy", dir=cache_dir)
+    with os.fdopen(fd, "wb") as f:
+        np.save(f, lut)
+
+    # **NOTE** on Windows, rename fails if another
+    # run has already written the same table
+    try:
+        os.rename(temp_path, path)
+    except OSError:
+        os.remove(temp_path)
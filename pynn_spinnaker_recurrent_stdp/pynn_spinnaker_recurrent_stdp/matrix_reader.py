@@ -0,0 +1,409 @@
+# Import modules
+import ctypes
+import numpy as np
+import os
+
+# Import classes
+from collections import namedtuple
+
+# Layout of control words used by all RecurrentSTDP builds
+# **NOTE** these must match the ControlDelayBits and
+# ControlIndexBits template arguments in runtime/build*/config.h
+CONTROL_INDEX_BITS = 10
+CONTROL_DELAY_BITS = 3
+
+# Synapse count, two delay extension words, time of last update, time of
+# last presynaptic spike and one word of pre-trace precede the plastic words
+# **NOTE** this must match MatrixReader::RowHeaderWords
+# in runtime/matrix_reader/matrix_reader.h
+ROW_HEADER_WORDS = 6
+
+# The learning state of a row consists of its synapse count, time of last
+# update, time of last presynaptic spike and pre-trace word followed by
+# its plastic words. Delay extension and control words aren't included as
+# they are rebuilt by the host whenever the network is loaded
+# **NOTE** this must match RecurrentSTDP::RowStateHeaderWords
+# and RecurrentSTDP::WriteRowState in runtime/recurrent_stdp.h
+ROW_STATE_HEADER_WORDS = 4
+
+# Version of the row learning state files written by save_row_states
+# **NOTE** this should be incremented whenever the row layout changes
+ROW_STATE_FILE_VERSION = 1
+
+# Arrays, with an element per synapse, synapses are decoded into
+Synapses = namedtuple("Synapses", ["pre", "post", "delay",
+                                   "weight", "accumulator"])
+
+# Description of a block of rows within a synaptic matrix region
+#   `word_offset`:
+#       Offset of first row from start of image (words).
+#   `pre_start`:
+#       Index of presynaptic neuron associated with first row.
+#   `num_rows`:
+#       Number of rows, one per presynaptic neuron.
+#   `max_row_synapses`:
+#       Maximum number of synapses in each row - rows are laid out in
+#       SDRAM with a stride large enough to contain this many synapses.
+#   `delay`:
+#       Delay added to those in the control words (timesteps) - non-zero
+#       for the rows of delay extensions.
+SubMatrix = namedtuple("SubMatrix", ["word_offset", "pre_start", "num_rows",
+                                     "max_row_synapses", "delay"])
+
+# ------------------------------------------------------------------------------
+# Functions
+# ------------------------------------------------------------------------------
+def get_row_words(num_synapses, compact=False):
+    """
+    Number of words occupied by a row containing num_synapses synapses.
+    **NOTE** this must match RecurrentSTDP::GetRowWords in runtime/recurrent_stdp.h
+    """
+    plastic_words = num_synapses if not compact else (num_synapses + 1) // 2
+    control_words = (num_synapses + 1) // 2
+    return ROW_HEADER_WORDS + plastic_words + control_words
+
+
+def read_synapses(image, sub_matrices, post_start=0, compact=False,
+                  num_threads=None):
+    """
+    Decode every plastic synapse from a memory image of a RecurrentSTDP
+    synapse processor's synaptic matrix region
+
+    Arguments:
+        `image`:
+            Path of file containing image, which is memory-mapped rather
+            than read, or image as a bytes-like object or array of uint32.
+        `sub_matrices`:
+            Sequence of SubMatrix tuples describing the blocks of rows
+            within the image.
+        `post_start`:
+            Index of first post-synaptic neuron handled by synapse processor.
+        `compact`:
+            Was image written by RecurrentSTDPCompactSynapse.
+        `num_threads`:
+            Number of threads to decode rows with. If None, one thread per
+            hardware thread is used. Only used by the native decoder.
+
+    Returns:
+        Synapses tuple of arrays containing the presynaptic index,
+        post-synaptic index, delay (timesteps), weight (in the fixed-point
+        format selected by the synaptic matrix region) and accumulator
+        (S2011 fixed-point) of each synapse.
+    """
+    image = _get_image(image)
+
+    # Build arrays describing each row
+    row_offsets = []
+    row_pre_indices = []
+    row_delays = []
+    for s in sub_matrices:
+        row_stride = get_row_words(s.max_row_synapses, compact)
+        row_offsets.append(s.word_offset +
+                           (np.arange(s.num_rows, dtype=np.uint64) * row_stride))
+        row_pre_indices.append(s.pre_start +
+                               np.arange(s.num_rows, dtype=np.uint32))
+        row_delays.append(np.full(s.num_rows, s.delay, dtype=np.uint32))
+
+    row_offsets = np.ascontiguousarray(np.concatenate(row_offsets), dtype=np.uint64)
+    row_pre_indices = np.ascontiguousarray(np.concatenate(row_pre_indices), dtype=np.uint32)
+    row_delays = np.ascontiguousarray(np.concatenate(row_delays), dtype=np.uint32)
+
+    # Check row headers are within image
+    if np.any(row_offsets >= len(image)):
+        raise ValueError("Sub-matrices extend beyond end of image")
+
+    # Read synapse count from first word of each row and use
+    # to calculate where each row's synapses should be written
+    row_synapses = image[row_offsets].astype(np.uint64)
+    synapse_offsets = np.zeros(len(row_offsets) + 1, dtype=np.uint64)
+    np.cumsum(row_synapses, out=synapse_offsets[1:])
+
+    # Allocate arrays and decode rows into them
+    num_synapses = int(synapse_offsets[-1])
+    synapses = Synapses(pre=np.empty(num_synapses, dtype=np.uint32),
+                        post=np.empty(num_synapses, dtype=np.uint32),
+                        delay=np.empty(num_synapses, dtype=np.uint32),
+                        weight=np.empty(num_synapses, dtype=np.int32),
+                        accumulator=np.empty(num_synapses, dtype=np.int32))
+    if _library is not None:
+        _decode_rows_native(image, row_offsets, row_pre_indices, row_delays,
+                            synapse_offsets, post_start, compact,
+                            num_threads, synapses)
+    else:
+        _decode_rows_numpy(image, row_offsets, row_pre_indices, row_delays,
+                           row_synapses, synapse_offsets, post_start,
+                           compact, synapses)
+    return synapses
+
+
+def read_weights(image, sub_matrices, num_pre, num_post, weight_fixed_point,
+                 post_start=0, compact=False, dense=True, num_threads=None):
+    """
+    Decode the weights and accumulators of every plastic synapse from a
+    memory image of a RecurrentSTDP synapse processor's synaptic matrix region
+
+    Arguments:
+        `image`, `sub_matrices`, `post_start`, `compact`, `num_threads`:
+            As for read_synapses.
+        `num_pre`:
+            Number of presynaptic neurons in projection.
+        `num_post`:
+            Number of post-synaptic neurons in projection.
+        `weight_fixed_point`:
+            Number of fractional bits in fixed-point weight format
+            selected by the synaptic matrix region.
+        `dense`:
+            Should weights be returned as dense matrices rather than
+            as sparse, coordinate format, arrays.
+
+    Returns:
+        If `dense`, a tuple of num_pre x num_post weight and accumulator
+        arrays with NaN where neurons aren't connected. **NOTE** if neurons
+        are connected by more than one synapse, only the last is included.
+        Otherwise a tuple of pre-synaptic index, post-synaptic index,
+        weight and accumulator arrays with an element per synapse.
+    """
+    synapses = read_synapses(image, sub_matrices, post_start, compact,
+                             num_threads)
+
+    # Convert fixed-point weights and accumulators to float
+    weight = synapses.weight / float(1 << weight_fixed_point)
+    accumulator = synapses.accumulator / 2048.0
+
+    # If sparse matrix is required, return coordinates
+    if not dense:
+        return synapses.pre, synapses.post, weight, accumulator
+
+    # Scatter into dense matrices
+    dense_weight = np.full((num_pre, num_post), np.nan)
+    dense_accumulator = np.full((num_pre, num_post), np.nan)
+    dense_weight[synapses.pre, synapses.post] = weight
+    dense_accumulator[synapses.pre, synapses.post] = accumulator
+    return dense_weight, dense_accumulator
+
+
+def read_row_states(image, sub_matrices, compact=False):
+    """
+    Read the learning state held in each row of a memory image of a
+    RecurrentSTDP synapse processor's synaptic matrix region so that it can
+    be checkpointed alongside the state written by WriteStateSDRAMData
+
+    Arguments:
+        `image`, `sub_matrices`, `compact`:
+            As for read_synapses.
+
+    Returns:
+        Array of uint32 containing the learning state of each row in the
+        format written by RecurrentSTDP::WriteRowState, in sub-matrix order.
+    """
+    image = _get_image(image)
+    indices, _ = _get_row_state_indices(image, sub_matrices, compact)
+    return image[indices]
+
+
+def write_row_states(image, sub_matrices, row_states, compact=False):
+    """
+    Restore the learning state of each row, read using read_row_states, into
+    a memory image of a synaptic matrix region e.g. one read from SDRAM after
+    the same network has been re-loaded. The image can then be written back
+    before the simulation is continued.
+
+    Arguments:
+        `image`:
+            Writable array of uint32 containing the image.
+        `sub_matrices`, `compact`:
+            As for read_synapses.
+        `row_states`:
+            Array of uint32 returned by read_row_states.
+    """
+    indices, row_state_starts = _get_row_state_indices(image, sub_matrices,
+                                                       compact)
+
+    # Check rows have the same synapse counts as those the state was read
+    # from - the first word of each row's state is its synapse count
+    row_states = np.asarray(row_states, dtype=np.uint32)
+    if (len(row_states) != len(indices) or
+            np.any(row_states[row_state_starts] !=
+                   image[indices[row_state_starts]])):
+        raise ValueError("Row learning state was read from "
+                         "rows with different synapse counts")
+
+    image[indices] = row_states
+
+
+def save_row_states(path, image, sub_matrices, compact=False):
+    """
+    Save the learning state of each row in a memory image
+    of a synaptic matrix region to a numpy .npz file
+
+    Arguments:
+        `path`:
+            Path of file to write.
+        `image`, `sub_matrices`, `compact`:
+            As for read_synapses.
+    """
+    np.savez(path, version=ROW_STATE_FILE_VERSION, compact=compact,
+             sub_matrices=np.asarray(sub_matrices, dtype=np.int64),
+             row_states=read_row_states(image, sub_matrices, compact))
+
+
+def load_row_states(path, image, sub_matrices, compact=False):
+    """
+    Restore the learning state of each row, saved using save_row_states,
+    into a memory image of a synaptic matrix region
+
+    Arguments:
+        `path`:
+            Path of file to read.
+        `image`, `sub_matrices`, `compact`:
+            As for write_row_states.
+    """
+    data = np.load(path)
+
+    # If file was written by a different version, from another
+    # synapse format or from different sub-matrices, give error
+    if int(data["version"]) != ROW_STATE_FILE_VERSION:
+        raise ValueError("Row learning state file version %u incompatible "
+                         "with version %u" % (int(data["version"]),
+                                              ROW_STATE_FILE_VERSION))
+    if bool(data["compact"]) != compact:
+        raise ValueError("Row learning state file was saved from "
+                         "a different synapse format")
+    if not np.array_equal(data["sub_matrices"],
+                          np.asarray(sub_matrices, dtype=np.int64)):
+        raise ValueError("Row learning state file was saved "
+                         "from different sub-matrices")
+
+    write_row_states(image, sub_matrices, data["row_states"], compact)
+
+
+def _get_image(image):
+    # If image is a path, memory-map it, otherwise create 32-bit view of data
+    if isinstance(image, str):
+        return np.memmap(image, dtype=np.uint32, mode="r")
+    else:
+        return np.frombuffer(image, dtype=np.uint32)
+
+
+def _get_row_state_indices(image, sub_matrices, compact):
+    # **NOTE** signed offsets are used throughout as mixing
+    # uint64 and int64 indices results in floating point
+    row_offsets = np.concatenate(
+        [s.word_offset + (np.arange(s.num_rows, dtype=np.int64) *
+                          get_row_words(s.max_row_synapses, compact))
+         for s in sub_matrices])
+
+    # Check row headers are within image
+    if np.any(row_offsets + ROW_HEADER_WORDS > len(image)):
+        raise ValueError("Sub-matrices extend beyond end of image")
+
+    # Calculate number of learning state words in each row
+    row_synapses = image[row_offsets].astype(np.int64)
+    plastic_words = (row_synapses if not compact
+                     else (row_synapses + 1) // 2)
+    row_state_words = ROW_STATE_HEADER_WORDS + plastic_words
+    if np.any(row_offsets + ROW_HEADER_WORDS + plastic_words > len(image)):
+        raise ValueError("Image contains rows which extend beyond end of image")
+
+    # Get index of row each state word is from and its index within that
+    # row's state. The synapse count is followed by the last three header
+    # words and the plastic words, skipping the two delay extension words
+    row_state_starts = np.zeros(len(row_offsets), dtype=np.int64)
+    np.cumsum(row_state_words[:-1], out=row_state_starts[1:])
+    word_row = np.repeat(np.arange(len(row_offsets)), row_state_words)
+    word_index = (np.arange(len(word_row), dtype=np.int64) -
+                  row_state_starts[word_row])
+    indices = row_offsets[word_row] + word_index + np.where(word_index > 0, 2, 0)
+    return indices, row_state_starts
+
+
+def _decode_rows_native(image, row_offsets, row_pre_indices, row_delays,
+                        synapse_offsets, post_start, compact, num_threads,
+                        synapses):
+    # **NOTE** ctypes releases the GIL while the decoder runs
+    result = _library.decode_rows(
+        image, len(image), row_offsets, row_pre_indices, row_delays,
+        synapse_offsets, len(row_offsets), CONTROL_INDEX_BITS,
+        CONTROL_DELAY_BITS, post_start, 1 if compact else 0,
+        0 if num_threads is None else num_threads,
+        synapses.pre, synapses.post, synapses.delay,
+        synapses.weight, synapses.accumulator)
+    if result != 0:
+        raise ValueError("Image contains rows which are malformed "
+                         "or extend beyond end of image")
+
+
+def _decode_rows_numpy(image, row_offsets, row_pre_indices, row_delays,
+                       row_synapses, synapse_offsets, post_start, compact,
+                       synapses):
+    # **NOTE** signed offsets are used throughout as mixing
+    # uint64 and int64 indices results in floating point
+    row_offsets = row_offsets.astype(np.int64)
+    row_synapses = row_synapses.astype(np.int64)
+    synapse_offsets = synapse_offsets.astype(np.int64)
+
+    # Get index of row each synapse is in and its index within that row
+    num_synapses = len(synapses.pre)
+    synapse_row = np.repeat(np.arange(len(row_offsets)), row_synapses)
+    synapse_index = (np.arange(num_synapses, dtype=np.int64) -
+                     synapse_offsets[:-1][synapse_row])
+
+    # Calculate offsets of each row's plastic and control words
+    plastic_offsets = row_offsets + ROW_HEADER_WORDS
+    control_offsets = (plastic_offsets +
+                       (row_synapses if not compact else (row_synapses + 1) // 2))
+
+    # Check all rows are within image
+    if np.any(control_offsets + ((row_synapses + 1) // 2) > len(image)):
+        raise ValueError("Image contains rows which extend beyond end of image")
+
+    # Gather plastic and control half-words of each synapse
+    half_words = image.view(np.uint16)
+    control = half_words[(control_offsets[synapse_row] * 2) +
+                         synapse_index].astype(np.uint32)
+
+    synapses.pre[:] = row_pre_indices[synapse_row]
+    synapses.post[:] = post_start + (control & ((1 << CONTROL_INDEX_BITS) - 1))
+    synapses.delay[:] = (row_delays[synapse_row] +
+                         ((control >> CONTROL_INDEX_BITS) &
+                          ((1 << CONTROL_DELAY_BITS) - 1)))
+
+    # Compact plastic synapses consist of an 8-bit weight in the low byte
+    # and an 8-bit accumulator with 6 fractional bits in the high byte
+    # **NOTE** this must match WeightAccumulator16 in runtime/weight_accumulator.h
+    if compact:
+        plastic = half_words[(plastic_offsets[synapse_row] * 2) + synapse_index]
+        synapses.weight[:] = (plastic & 0xFF).astype(np.int32) << 8
+        synapses.accumulator[:] = (plastic >> 8).astype(np.int8).astype(np.int32) * 32
+    # Otherwise, they consist of a 16-bit weight and 16-bit S2011 accumulator
+    # **NOTE** this must match WeightAccumulator32 in runtime/weight_accumulator.h
+    else:
+        plastic = image[plastic_offsets[synapse_row] + synapse_index]
+        synapses.weight[:] = plastic & 0xFFFF
+        synapses.accumulator[:] = (plastic >> 16).astype(np.uint16).view(np.int16)
+
+
+def _load_library():
+    # Load native decoder built by runtime/matrix_reader/Makefile if present
+    binary_dir = os.path.join(os.path.dirname(__file__), "binaries")
+    try:
+        library = np.ctypeslib.load_library("libmatrix_reader", binary_dir)
+    except OSError:
+        return None
+
+    # Define native decoder's signature
+    def array(dtype):
+        return np.ctypeslib.ndpointer(dtype=dtype, flags="C_CONTIGUOUS")
+
+    library.decode_rows.restype = ctypes.c_int
+    library.decode_rows.argtypes = [
+        array(np.uint32), ctypes.c_uint64,
+        array(np.uint64), array(np.uint32), array(np.uint32), array(np.uint64),
+        ctypes.c_uint32, ctypes.c_uint32, ctypes.c_uint32, ctypes.c_uint32,
+        ctypes.c_uint32, ctypes.c_uint32,
+        array(np.uint32), array(np.uint32), array(np.uint32),
+        array(np.int32), array(np.int32)]
+    return library
+
+# Native decoder or None if it hasn't been built
+_library = _load_library()
@@ -0,0 +1,103 @@
+# Import modules
+import numpy as np
+
+# Names of the tags the RecurrentSTDP synapse type uses to profile phases
+# of synapse processing. The per-synapse phases (window_lookup,
+# apply_post_spikes, accumulator_decay and apply_pre_spike) are sampled from
+# one synapse per row, rotating through synapse positions in successive rows,
+# so their durations are those of a single synapse rather than a whole row.
+# **NOTE** these must match the ProfilerTag enumeration in runtime/recurrent_stdp.h
+profiler_tag_names = {
+    16: "update_pre_trace",
+    17: "process_synapses",
+    18: "window_lookup",
+    19: "apply_post_spikes",
+    20: "accumulator_decay",
+    21: "apply_pre_spike",
+    22: "write_back",
+    23: "add_post_synaptic_spike",
+}
+
+# ------------------------------------------------------------------------------
+# Functions
+# ------------------------------------------------------------------------------
+def decode_profile(region_data, tag_names=profiler_tag_names):
+    """
+    Decode the contents of a core's profiler region into
+    the duration, in timer ticks, of each profiled phase
+
+    Arguments:
+        `region_data`:
+            Contents of profiler region as a bytes-like object or an array
+            of uint32. The first word is the number of samples which follow,
+            each consisting of a count-down timer value and a tag word whose
+            top bit is set on entry to a phase.
+        `tag_names`:
+            Dictionary mapping tags to the names of the phases they profile.
+
+    Returns:
+        Dictionary mapping the name of each phase to an array of durations.
+        On SpiNNaker the profiler timer runs at the processor clock
+        frequency so these durations are in cycles.
+    """
+    # Create 32-bit view of data
+    if isinstance(region_data, np.ndarray):
+        words = region_data.astype(np.uint32, copy=False)
+    else:
+        words = np.frombuffer(region_data, dtype=np.uint32)
+
+    # Slice samples from data and split into times, tags and flags
+    num_samples = int(words[0])
+    samples = words[1:1 + (num_samples * 2)]
+    sample_times = samples[::2]
+    sample_tags = np.bitwise_and(samples[1::2], 0x7FFFFFFF)
+    sample_entry = np.right_shift(samples[1::2], 31) == 1
+
+    durations = {}
+    for tag, name in tag_names.items():
+        # Find entries and exits associated with this tag
+        tag_samples = (sample_tags == tag)
+        entry_indices = np.where(tag_samples & sample_entry)[0]
+        exit_indices = np.where(tag_samples & ~sample_entry)[0]
+
+        # If profiling started part way through a phase, skip its exit
+        if len(exit_indices) > 0 and (len(entry_indices) == 0 or
+                                      exit_indices[0] < entry_indices[0]):
+            exit_indices = exit_indices[1:]
+        entry_times = sample_times[entry_indices]
+        exit_times = sample_times[exit_indices]
+
+        # If the profiler filled up part way through a phase, skip its entry
+        num_phases = min(len(entry_times), len(exit_times))
+
+        # As timer counts down, subtract exit times from entry
+        # times, wrapping the result to handle timer overflow
+        durations[name] = np.subtract(entry_times[:num_phases],
+                                      exit_times[:num_phases],
+                                      dtype=np.uint32)
+    return durations
+
+
+def get_phase_histograms(core_region_data, bins=32,
+                         tag_names=profiler_tag_names):
+    """
+    Build histograms of the duration of each profiled phase on each core
+
+    Arguments:
+        `core_region_data`:
+            Dictionary mapping cores to the contents of their profiler region.
+        `bins`:
+            Number of bins or sequence of bin edges passed to numpy.histogram.
+        `tag_names`:
+            Dictionary mapping tags to the names of the phases they profile.
+
+    Returns:
+        Dictionary mapping cores to dictionaries mapping the name of each
+        phase to the histogram counts and bin edges of its durations.
+    """
+    histograms = {}
+    for core, region_data in core_region_data.items():
+        durations = decode_profile(region_data, tag_names)
+        histograms[core] = {name: np.histogram(d, bins=bins)
+                            for name, d in durations.items() if len(d) > 0}
+    return histograms
@@ -10,25 +10,48 @@ import scipy.stats
 from pyNN.standardmodels.synapses import StandardSynapseType
 
 # Import functions
-from copy import deepcopy
 from functools import partial
 from pyNN.standardmodels import build_translations
 from pynn_spinnaker.spinnaker.utils import get_homogeneous_param
+from lut_cache import cached_lut
 
 # Import globals
 from pynn_spinnaker.simulator import state
 
+# Types of lookup table described by the header preceding each one
+# **NOTE** these must match the LUTHeader::Type enumeration
+# in runtime/lookup_tables.h
+LUT_TYPE_EXP_DECAY = 1
+LUT_TYPE_INVERSE_TRANSFORM_SAMPLE = 2
+
+# Generate the two word header which precedes each LUT so the runtime can
+# check the layout matches the one it was compiled with and that any LUT
+# baked into the binary was generated from the same time constant
+def lut_header(value, lut_type, num_entries, shift=0, **kwargs):
+    # Assert that value is is_homogeneous
+    assert value.is_homogeneous
+    value = value.evaluate(simplify=True)
+
+    layout = (lut_type << 24) | (shift << 16) | num_entries
+    return np.asarray([layout, int(round(value / state.dt))], dtype=np.uint32)
+
 # Generate a LUT for inverse transform sampling of exponential distribution
+@cached_lut
 def integer_exp_dist_its_lut(mean, **kwargs):
     # Assert that mean is is_homogeneous
     assert mean.is_homogeneous
-    mean = mean.evaluate(simplify=True)
+
+    # Convert mean to timesteps as windows are measured in timesteps
+    mean = mean.evaluate(simplify=True) / state.dt
 
     # Bind the mean to the correct PPF generator and use to generate an
     # inverse transform LUT from probabilities expressed with 11 fractional bits
     return la.rint(lazy_param_map.its_lut(
         partial(scipy.stats.expon.ppf, scale=mean), 11))
 
+# Generate a LUT of exponential decay, reusing any identical table
+s411_exp_decay_lut = cached_lut(lazy_param_map.s411_exp_decay_lut)
+
 # ------------------------------------------------------------------------------
 # RecurrentSTDPSynapse
 # ------------------------------------------------------------------------------
@@ -59,6 +82,16 @@ class RecurrentSTDPSynapse(StandardSynapseType):
             .
         `tau_a`:
             Is plasticity enabled.
+        `plasticity_off_start`:
+            Time at which plasticity is switched off (ms).
+        `plasticity_off_end`:
+            Time at which plasticity is switched back on (ms).
+        `axonal_delay`:
+            Delay between presynaptic spikes being emitted and arriving at
+            synapses (ms). This is added to the (dendritic) delay of each
+            connection so longer delays can be implemented without
+            delay-extension rows. Only supported, up to 8 timesteps,
+            by RecurrentSTDPDeepSynapse.
     """
     default_parameters = {
         "weight": 0.0,
@@ -72,6 +105,9 @@ class RecurrentSTDPSynapse(StandardSynapseType):
         "lambda_pre": 20.0,
         "lambda_post": 20.0,
         "tau_a": 100.0,
+        "plasticity_off_start": 0.0,
+        "plasticity_off_end": 0.0,
+        "axonal_delay": 0.0,
     }
 
 
@@ -91,7 +127,22 @@ class RecurrentSTDPSynapse(StandardSynapseType):
         ("lambda_post",           "lambda_post"),
 
         ("tau_a",                 "tau_a"),
+
+        ("plasticity_off_start",  "plasticity_off_start"),
+        ("plasticity_off_end",    "plasticity_off_end"),
+
+        ("axonal_delay",          "axonal_delay"),
     )
+
+    def __init__(self, **parameters):
+        super(RecurrentSTDPSynapse, self).__init__(**parameters)
+
+        # Check axonal delay can be handled by synapse processor's ring-buffer
+        axonal_delay = get_homogeneous_param(self.parameter_space, "axonal_delay")
+        if int(round(axonal_delay / state.dt)) > self._max_axonal_delay:
+            raise ValueError("%s only supports axonal delays of up to %u "
+                             "timesteps" % (type(self).__name__,
+                                            self._max_axonal_delay))
     
     def _get_minimum_delay(self):
         d = state.min_delay
@@ -102,9 +153,22 @@ class RecurrentSTDPSynapse(StandardSynapseType):
     # --------------------------------------------------------------------------
     # Internal SpiNNaker properties
     # --------------------------------------------------------------------------
+    # **NOTE** the runtime supports a table of parameter sets (from
+    # "w_min" to "tau_a") selected by an index in each row's presynaptic
+    # state but, as rows are currently always written with an index of
+    # zero, only a single parameter set follows the core-wide parameters
+    # **NOTE** this must match the order in RecurrentSTDP::ReadSDRAMData
     _plasticity_param_map = [
         (lazy_param_map.mars_kiss_64_random_seed, "4i4"),
 
+        ("plasticity_off_start",  "u4", lazy_param_map.integer_time_divide),
+        ("plasticity_off_end",    "u4", lazy_param_map.integer_time_divide),
+
+        ("lambda_post",           "2u4", partial(lut_header,
+                                                 lut_type=LUT_TYPE_INVERSE_TRANSFORM_SAMPLE,
+                                                 num_entries=2048)),
+        ("lambda_post",           "2048i2", integer_exp_dist_its_lut),
+
         ("w_min",                 "i4", lazy_param_map.s2011),
         ("w_max",                 "i4", lazy_param_map.s2011),
         ("a_plus",                "i4", lazy_param_map.s2011),
@@ -113,16 +177,25 @@ class RecurrentSTDPSynapse(StandardSynapseType):
         ("accumulator_increase",  "i4", lazy_param_map.s2011),
         ("accumulator_decrease",  "i4", lazy_param_map.s2011),
 
+        ("axonal_delay",          "u4", lazy_param_map.integer_time_divide),
+
+        ("lambda_pre",            "2u4", partial(lut_header,
+                                                 lut_type=LUT_TYPE_INVERSE_TRANSFORM_SAMPLE,
+                                                 num_entries=2048)),
         ("lambda_pre",            "2048i2", integer_exp_dist_its_lut),
-        ("lambda_post",           "2048i2", integer_exp_dist_its_lut),
 
-        ("tau_a",                 "1500i2", partial(lazy_param_map.s411_exp_decay_lut,
-                                                    num_entries=1500, time_shift=5)),
+        ("tau_a",                 "2u4", partial(lut_header,
+                                                 lut_type=LUT_TYPE_EXP_DECAY,
+                                                 num_entries=512, shift=5)),
+        ("tau_a",                 "512i2", partial(s411_exp_decay_lut,
+                                                   num_entries=512, time_shift=5)),
     ]
 
     _comparable_param_names = ("w_min", "w_max", "A_plus", "A_minus",
                               "accumulator_increase", "accumulator_decrease",
-                              "lambda_pre", "lambda_post", "tau_a")
+                              "lambda_pre", "lambda_post", "tau_a",
+                              "plasticity_off_start", "plasticity_off_end",
+                              "axonal_delay")
 
     # How many post-synaptic neurons per core can a
     # SpiNNaker synapse_processor of this type handle
@@ -141,6 +214,10 @@ class RecurrentSTDPSynapse(StandardSynapseType):
     # 8 element delay buffer - The last element is purely for output
     _max_dtcm_delay_slots = 7
 
+    # How many timesteps of axonal delay can synapse_processor handle
+    # **NOTE** this must match the A template argument in runtime/build*/config.h
+    _max_axonal_delay = 0
+
     # Static weights are unsigned
     _signed_weight = False
 
@@ -151,6 +228,8 @@ class RecurrentSTDPSynapse(StandardSynapseType):
     # The presynaptic state for recurrent STDP synapses consists of a
     # uint32 containing time of last update a uint32 containing time of last
     # presynaptic spike and uint16 containing presynaptic window length
+    # **NOTE** the runtime reads the index of the row's parameter set from
+    # the uint16 of padding following this
     _pre_state_bytes = 10
 
     # Each synape has an additional 16-bit trace: accumulator
@@ -158,4 +237,143 @@ class RecurrentSTDPSynapse(StandardSynapseType):
 
     def _update_weight_range(self, weight_range):
         weight_range.update(get_homogeneous_param(self.parameter_space, "w_max"))
-        weight_range.update(get_homogeneous_param(self.parameter_space, "w_min"))
\ No newline at end of file
+        weight_range.update(get_homogeneous_param(self.parameter_space, "w_min"))
+
+
+# ------------------------------------------------------------------------------
+# RecurrentSTDPWideSynapse
+# ------------------------------------------------------------------------------
+class RecurrentSTDPWideSynapse(RecurrentSTDPSynapse):
+    """
+    Recurrent STDP synapse using a synapse processor which handles twice as
+    many post-synaptic neurons as RecurrentSTDPSynapse but only retains the
+    last 4 spikes emitted by each (rather than 10) and
+    doesn't support axonal delays
+    """
+    # --------------------------------------------------------------------------
+    # Internal SpiNNaker properties
+    # --------------------------------------------------------------------------
+    _max_post_neurons_per_core = 512
+
+    # 512 neuron ring-buffer only has 8 slots so no axonal delay is supported
+    _max_axonal_delay = 0
+
+
+# ------------------------------------------------------------------------------
+# RecurrentSTDPDeepSynapse
+# ------------------------------------------------------------------------------
+class RecurrentSTDPDeepSynapse(RecurrentSTDPSynapse):
+    """
+    Recurrent STDP synapse using a synapse processor which handles half as
+    many post-synaptic neurons as RecurrentSTDPSynapse but retains the last
+    24 spikes emitted by each (rather than 10) so fast-firing post-synaptic
+    neurons require fewer flush events. It also supports axonal delays
+    """
+    # --------------------------------------------------------------------------
+    # Internal SpiNNaker properties
+    # --------------------------------------------------------------------------
+    _max_post_neurons_per_core = 128
+
+    # Ring-buffer has 16 rather than 8 slots so axonal delays are supported
+    _max_axonal_delay = 8
+
+
+# ------------------------------------------------------------------------------
+# RecurrentSTDPCompressedSynapse
+# ------------------------------------------------------------------------------
+class RecurrentSTDPCompressedSynapse(RecurrentSTDPSynapse):
+    """
+    Recurrent STDP synapse using a synapse processor which stores each
+    post-synaptic spike as an 8-bit offset from the previous one rather than
+    a 32-bit time so it retains up to 20 spikes emitted by each post-synaptic
+    neuron (rather than 10) in roughly the same DTCM. Fast-firing
+    post-synaptic neurons therefore require fewer flush events
+    """
+
+
+# ------------------------------------------------------------------------------
+# RecurrentSTDPBakedSynapse
+# ------------------------------------------------------------------------------
+class RecurrentSTDPBakedSynapse(RecurrentSTDPSynapse):
+    """
+    Recurrent STDP synapse using a synapse processor with the lookup tables
+    for the default tau_a, lambda_pre and lambda_post (at a 0.1ms timestep)
+    generated at compile time rather than loaded into DTCM. Only these
+    values are supported and only the headers of the lookup tables are
+    written so the synapse processor can check they match.
+    """
+    # Time constant and means baked into the binary [timesteps]
+    # **NOTE** these must match the template arguments
+    # in runtime/build_baked/config.h
+    _baked_ticks = {"tau_a": 1000, "lambda_pre": 200, "lambda_post": 200}
+
+    def __init__(self, **parameters):
+        super(RecurrentSTDPBakedSynapse, self).__init__(**parameters)
+
+        # Check parameters match those baked into the binary
+        for name, ticks in self._baked_ticks.items():
+            value = get_homogeneous_param(self.parameter_space, name)
+            if int(round(value / state.dt)) != ticks:
+                raise ValueError("RecurrentSTDPBakedSynapse only supports "
+                                 "%s of %u timesteps" % (name, ticks))
+
+    # --------------------------------------------------------------------------
+    # Internal SpiNNaker properties
+    # --------------------------------------------------------------------------
+    # Only the headers of baked lookup tables are written
+    # and these describe tables with no entries
+    _plasticity_param_map = [
+        (lazy_param_map.mars_kiss_64_random_seed, "4i4"),
+
+        ("plasticity_off_start",  "u4", lazy_param_map.integer_time_divide),
+        ("plasticity_off_end",    "u4", lazy_param_map.integer_time_divide),
+
+        ("lambda_post",           "2u4", partial(lut_header,
+                                                 lut_type=LUT_TYPE_INVERSE_TRANSFORM_SAMPLE,
+                                                 num_entries=0)),
+
+        ("w_min",                 "i4", lazy_param_map.s2011),
+        ("w_max",                 "i4", lazy_param_map.s2011),
+        ("a_plus",                "i4", lazy_param_map.s2011),
+        ("a_minus",               "i4", lazy_param_map.s2011),
+
+        ("accumulator_increase",  "i4", lazy_param_map.s2011),
+        ("accumulator_decrease",  "i4", lazy_param_map.s2011),
+
+        ("axonal_delay",          "u4", lazy_param_map.integer_time_divide),
+
+        ("lambda_pre",            "2u4", partial(lut_header,
+                                                 lut_type=LUT_TYPE_INVERSE_TRANSFORM_SAMPLE,
+                                                 num_entries=0)),
+
+        ("tau_a",                 "2u4", partial(lut_header,
+                                                 lut_type=LUT_TYPE_EXP_DECAY,
+                                                 num_entries=0, shift=5)),
+    ]
+
+
+# ------------------------------------------------------------------------------
+# RecurrentSTDPCompactSynapse
+# ------------------------------------------------------------------------------
+class RecurrentSTDPCompactSynapse(RecurrentSTDPSynapse):
+    """
+    Recurrent STDP synapse using a synapse processor which packs an 8-bit
+    weight and an 8-bit accumulator into each 16-bit plastic synapse
+    (rather than 16-bit weights and accumulators) so roughly half as much
+    plastic data is transferred each time a row is processed
+    """
+    # --------------------------------------------------------------------------
+    # Internal SpiNNaker properties
+    # --------------------------------------------------------------------------
+    # Compact synapses store weight and accumulator in the 16-bit weight
+    # itself so require a standard synaptic matrix region
+    _synaptic_matrix_region_class = regions.PlasticSynapticMatrix
+
+    # Compact synapses don't have an additional trace
+    _synapse_trace_bytes = 0
+
+    def _update_weight_range(self, weight_range):
+        # Scale weight range so the fixed-point format selected for
+        # 16-bit weights leaves weights within the low 8 bits
+        weight_range.update(get_homogeneous_param(self.parameter_space, "w_max") * 256.0)
+        weight_range.update(get_homogeneous_param(self.parameter_space, "w_min") * 256.0)
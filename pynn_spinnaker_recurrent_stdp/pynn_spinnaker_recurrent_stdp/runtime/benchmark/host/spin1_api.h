@@ -0,0 +1,24 @@
+#pragma once
+
+//-----------------------------------------------------------------------------
+// Minimal host-side replacement for the parts of the SpiNNaker API used by
+// the synapse processor headers so they can be compiled natively
+//-----------------------------------------------------------------------------
+// Standard includes
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+
+typedef unsigned int uint;
+
+// IO streams are all redirected to stdout
+#define IO_BUF ((char*)1)
+#define IO_STD ((char*)2)
+
+static inline void io_printf(char *, const char *format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  vprintf(format, args);
+  va_end(args);
+}
@@ -0,0 +1,662 @@
+// Standard includes
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Common includes
+#include "common/random/mars_kiss64.h"
+
+// Recurrent STDP includes
+#include "../compressed_post_events.h"
+#include "../recurrent_stdp.h"
+
+//-----------------------------------------------------------------------------
+// Anonymous namespace
+//-----------------------------------------------------------------------------
+namespace
+{
+//-----------------------------------------------------------------------------
+// Constants
+//-----------------------------------------------------------------------------
+// Template arguments matching build_deep/config.h rather than the default
+// build/config.h (no axonal delay and a ring-buffer with 3 delay bits) so
+// axonally-delayed rows can be measured - the number of post-synaptic
+// neurons and history are chosen separately below and by each sweep
+const unsigned int ControlDelayBits = 3;
+const unsigned int ControlIndexBits = 10;
+const unsigned int MaxAxonalDelay = 8;
+const unsigned int RingBufferDelayBits = 4;
+const unsigned int TauALUTNumEntries = 512;
+const unsigned int TauALUTShift = 5;
+const unsigned int NumParamSets = 1;
+
+// Number of post-synaptic neurons handled by a synapse processor
+const unsigned int NumPostNeurons = 256;
+
+// Maximum number of synapses in a row
+const unsigned int MaxRowSynapses = 170;
+
+// Number of delay slots which can be encoded in control words
+const unsigned int NumDelaySlots = 1 << ControlDelayBits;
+
+// Number of delay slots in the stub ring-buffer
+const unsigned int NumRingBufferDelaySlots = 1 << RingBufferDelayBits;
+
+// Number of distinct presynaptic rows to cycle through
+const unsigned int NumRows = 512;
+
+// Number of rows processed each simulated tick
+const unsigned int RowsPerTick = 32;
+
+// Probability of each row spiking each tick when measuring flush events
+const double FlushPreRate = 0.002;
+
+// Plasticity parameters written into the synthetic SDRAM region
+const double MeanPreWindow = 20.0;
+const double MeanPostWindow = 20.0;
+const double TauA = 100.0;
+
+//-----------------------------------------------------------------------------
+// Stub synapse processor state
+//-----------------------------------------------------------------------------
+struct WriteBack
+{
+  uint32_t *m_SDRAMAddress;
+  const uint32_t *m_Source;
+  unsigned int m_NumWords;
+};
+
+uint32_t g_RingBuffer[NumRingBufferDelaySlots * NumPostNeurons];
+std::vector<WriteBack> g_PendingWriteBacks;
+unsigned int g_NumDelayRows = 0;
+unsigned int g_NumWriteBackWords = 0;
+
+//-----------------------------------------------------------------------------
+// Results
+//-----------------------------------------------------------------------------
+struct Result
+{
+  double m_SynapticEventsPerSecond;
+  double m_NanosecondsPerSynapse;
+  double m_NanosecondsPerRow;
+  double m_WriteBackWordsPerRow;
+  double m_NanosecondsPerPostSpike;
+};
+
+struct FlushResult
+{
+  unsigned int m_NumFlushes;
+  unsigned int m_NumTruncatedWindows;
+};
+
+struct CheckpointResult
+{
+  unsigned int m_StateBytes;
+  unsigned int m_RowStateBytes;
+  double m_SaveMicroseconds;
+  double m_LoadMicroseconds;
+  double m_ReplayMicroseconds;
+};
+
+//-----------------------------------------------------------------------------
+// Post-synaptic event history types
+//-----------------------------------------------------------------------------
+template<typename T, unsigned int N>
+using Standard = SynapseProcessor::Plasticity::PostEventHistory<T, N>;
+
+template<typename T, unsigned int N>
+using Compressed = ExtraModels::CompressedPostEventHistory<T, N>;
+
+//-----------------------------------------------------------------------------
+// Plastic synapse types
+//-----------------------------------------------------------------------------
+typedef ExtraModels::WeightAccumulator32 Wide;
+typedef ExtraModels::WeightAccumulator16 Compact;
+
+//-----------------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------------
+int16_t ToS2011(double value)
+{
+  return (int16_t)std::round(value * 2048.0);
+}
+//-----------------------------------------------------------------------------
+void WriteExpDistLUT(std::vector<uint32_t> &region, double mean)
+{
+  // Header describing table
+  region.push_back(ExtraModels::LUTHeader::Build(ExtraModels::LUTHeader::TypeInverseTransformSample, 2048, 0));
+  region.push_back((uint32_t)std::round(mean));
+
+  // Inverse CDF of exponential distribution
+  // sampled with 11 fractional bits of probability
+  std::vector<uint16_t> lut(2048);
+  for(unsigned int i = 0; i < 2048; i++)
+  {
+    const double p = (double)i / 2048.0;
+    lut[i] = (uint16_t)std::round(-mean * std::log(1.0 - p));
+  }
+
+  const size_t start = region.size();
+  region.resize(start + (lut.size() / 2));
+  memcpy(&region[start], lut.data(), lut.size() * sizeof(uint16_t));
+}
+//-----------------------------------------------------------------------------
+void WriteExpDecayLUT(std::vector<uint32_t> &region, double tau,
+                      unsigned int numEntries, unsigned int shift)
+{
+  // Header describing table
+  region.push_back(ExtraModels::LUTHeader::Build(ExtraModels::LUTHeader::TypeExpDecay, numEntries, shift));
+  region.push_back((uint32_t)std::round(tau));
+
+  // Exponential decay in S2011 format
+  std::vector<int16_t> lut(numEntries + (numEntries % 2));
+  for(unsigned int i = 0; i < numEntries; i++)
+  {
+    lut[i] = ToS2011(std::exp(-(double)(i << shift) / tau));
+  }
+
+  const size_t start = region.size();
+  region.resize(start + (lut.size() / 2));
+  memcpy(&region[start], lut.data(), lut.size() * sizeof(int16_t));
+}
+//-----------------------------------------------------------------------------
+std::vector<uint32_t> BuildPlasticityRegion(uint32_t seed, bool plastic)
+{
+  std::vector<uint32_t> region;
+
+  // RNG seed
+  std::mt19937 seedGenerator(seed);
+  for(unsigned int s = 0; s < Common::Random::MarsKiss64::StateSize; s++)
+  {
+    region.push_back(seedGenerator());
+  }
+
+  // Range of ticks during which plasticity is switched off
+  region.push_back(0);
+  region.push_back(plastic ? 0 : UINT32_MAX);
+
+  // Postsynaptic window length distribution
+  WriteExpDistLUT(region, MeanPostWindow);
+
+  // Identical parameter sets
+  for(unsigned int p = 0; p < NumParamSets; p++)
+  {
+    // Weight limits, weight update sizes and accumulator steps
+    region.push_back((uint32_t)(int32_t)ToS2011(0.0));
+    region.push_back((uint32_t)(int32_t)ToS2011(1.0));
+    region.push_back((uint32_t)(int32_t)ToS2011(0.1));
+    region.push_back((uint32_t)(int32_t)ToS2011(0.1));
+    region.push_back((uint32_t)(int32_t)ToS2011(0.2));
+    region.push_back((uint32_t)(int32_t)ToS2011(0.2));
+
+    // Axonal delay
+    region.push_back(0);
+
+    // Presynaptic window length distribution
+    WriteExpDistLUT(region, MeanPreWindow);
+
+    // Accumulator decay
+    WriteExpDecayLUT(region, TauA, TauALUTNumEntries, TauALUTShift);
+  }
+  return region;
+}
+//-----------------------------------------------------------------------------
+template<typename P, typename SynapseType>
+std::vector<uint32_t> BuildRow(const SynapseType &synapse, unsigned int rowSynapses,
+                               std::mt19937 &rng)
+{
+  std::vector<uint32_t> row(synapse.GetRowWords(rowSynapses), 0);
+
+  // Synapse count; no delay extension; last update, last pre-spike and trace all zero
+  row[0] = rowSynapses;
+
+  // Plastic synapses start after five header words and the pre-trace; the
+  // 16-bit control words follow them. The offset of the control words is
+  // recovered from the total row size
+  const unsigned int controlWords = (rowSynapses + 1) / 2;
+  const unsigned int plasticStart = 6;
+  const unsigned int controlStart = row.size() - controlWords;
+
+  std::uniform_int_distribution<uint32_t> weightDist(0, 2048);
+  std::uniform_int_distribution<uint32_t> indexDist(0, NumPostNeurons - 1);
+  std::uniform_int_distribution<uint32_t> delayDist(1, NumDelaySlots - 1);
+
+  P *plastic = reinterpret_cast<P*>(&row[plasticStart]);
+  uint16_t *control = reinterpret_cast<uint16_t*>(&row[controlStart]);
+  for(unsigned int s = 0; s < rowSynapses; s++)
+  {
+    // Random weight and zero accumulator
+    plastic[s] = P(weightDist(rng), 0);
+
+    control[s] = (uint16_t)(indexDist(rng) | (delayDist(rng) << ControlIndexBits));
+  }
+
+  return row;
+}
+//-----------------------------------------------------------------------------
+template<typename P, template<typename, unsigned int> class H, unsigned int T>
+Result Run(unsigned int rowSynapses, double postRate, bool plastic,
+           unsigned int numTicks)
+{
+  typedef ExtraModels::RecurrentSTDP<uint16_t, P, ControlDelayBits, ControlIndexBits, MaxAxonalDelay,
+                                     NumPostNeurons, MaxRowSynapses,
+                                     TauALUTNumEntries, TauALUTShift, NumParamSets,
+                                     H, T, Common::Random::MarsKiss64> SynapseType;
+
+  // Load synapse type from synthetic plasticity region
+  std::unique_ptr<SynapseType> synapse(new SynapseType());
+  std::vector<uint32_t> region = BuildPlasticityRegion(1234, plastic);
+  synapse->ReadSDRAMData(region.data(), 0, 0);
+
+  // Build synthetic 'SDRAM' rows
+  std::mt19937 rng(5678);
+  std::vector<std::vector<uint32_t>> rows;
+  for(unsigned int r = 0; r < NumRows; r++)
+  {
+    rows.push_back(BuildRow<P>(*synapse, rowSynapses, rng));
+  }
+
+  // DMA buffers, one for each row processed in a tick
+  static uint32_t dmaBuffers[RowsPerTick][SynapseType::MaxRowWords];
+
+  std::bernoulli_distribution postSpikeDist(postRate);
+  std::uniform_int_distribution<unsigned int> rowDist(0, NumRows - 1);
+
+  auto applyInput = [](unsigned int tick, unsigned int index, int weight)
+  {
+    g_RingBuffer[((tick % NumRingBufferDelaySlots) * NumPostNeurons) + index] += weight;
+  };
+  auto addDelayRow = [](unsigned int, uint32_t, bool)
+  {
+    g_NumDelayRows++;
+  };
+  auto writeBackRow = [](uint32_t *sdramAddress, uint32_t *localAddress, unsigned int numWords)
+  {
+    g_PendingWriteBacks.push_back({sdramAddress, localAddress, numWords});
+    g_NumWriteBackWords += numWords;
+  };
+
+  g_NumWriteBackWords = 0;
+  std::chrono::nanoseconds duration(0);
+  std::chrono::nanoseconds postDuration(0);
+  unsigned int numPostSpikes = 0;
+  unsigned int rowIndices[RowsPerTick];
+  std::vector<unsigned int> postSpikes;
+  for(unsigned int tick = 1; tick <= numTicks; tick++)
+  {
+    // Pick post-synaptic neurons which spike this tick
+    postSpikes.clear();
+    for(unsigned int n = 0; n < NumPostNeurons; n++)
+    {
+      if(postSpikeDist(rng))
+      {
+        postSpikes.push_back(n);
+      }
+    }
+
+    // Back-propagate spikes from post-synaptic neurons
+    const auto postStart = std::chrono::high_resolution_clock::now();
+    for(const unsigned int n : postSpikes)
+    {
+      synapse->AddPostSynapticSpike(tick, n);
+    }
+    postDuration += std::chrono::high_resolution_clock::now() - postStart;
+    numPostSpikes += postSpikes.size();
+
+    // 'DMA' incoming rows into buffers
+    for(unsigned int r = 0; r < RowsPerTick; r++)
+    {
+      rowIndices[r] = rowDist(rng);
+      const auto &row = rows[rowIndices[r]];
+      memcpy(dmaBuffers[r], row.data(), row.size() * sizeof(uint32_t));
+    }
+
+    // Process rows
+    g_PendingWriteBacks.clear();
+    const auto start = std::chrono::high_resolution_clock::now();
+    for(unsigned int r = 0; r < RowsPerTick; r++)
+    {
+      synapse->ProcessRow(tick, dmaBuffers[r], rows[rowIndices[r]].data(), false,
+                         applyInput, addDelayRow, writeBackRow);
+    }
+    duration += std::chrono::high_resolution_clock::now() - start;
+
+    // 'DMA' written back data into rows
+    for(const auto &w : g_PendingWriteBacks)
+    {
+      memcpy(w.m_SDRAMAddress, w.m_Source, w.m_NumWords * sizeof(uint32_t));
+    }
+  }
+
+  const double numRows = (double)numTicks * (double)RowsPerTick;
+  const double numSynapticEvents = numRows * (double)rowSynapses;
+  const double nanoseconds = (double)duration.count();
+
+  return Result{numSynapticEvents * 1.0E9 / nanoseconds,
+                nanoseconds / numSynapticEvents,
+                nanoseconds / numRows,
+                (double)g_NumWriteBackWords / numRows,
+                (double)postDuration.count() / (double)numPostSpikes};
+}
+//-----------------------------------------------------------------------------
+template<unsigned int A, unsigned int N, unsigned int S, typename P,
+         template<typename, unsigned int> class H, unsigned int T>
+void PrintFootprint(const char *name, unsigned int ringBufferDelayBits)
+{
+  typedef ExtraModels::RecurrentSTDP<uint16_t, P, ControlDelayBits, ControlIndexBits, A,
+                                     N, S,
+                                     TauALUTNumEntries, TauALUTShift, NumParamSets,
+                                     H, T, Common::Random::MarsKiss64> SynapseType;
+
+  // Synapse type state, ring-buffer with 32-bit entries and a row DMA buffer
+  const unsigned int synapseBytes = sizeof(SynapseType);
+  const unsigned int ringBufferBytes = (1 << ringBufferDelayBits) * N * sizeof(uint32_t);
+  const unsigned int dmaBufferBytes = SynapseType::MaxRowWords * sizeof(uint32_t);
+  printf("%-16s %7u %7u %14u %18u %16u %12u\n",
+         name, N, T, synapseBytes, ringBufferBytes, dmaBufferBytes,
+         synapseBytes + ringBufferBytes + dmaBufferBytes);
+}
+//-----------------------------------------------------------------------------
+template<typename P, template<typename, unsigned int> class H, unsigned int T>
+void RunSweep(const char *format, bool plastic, unsigned int numTicks)
+{
+  const unsigned int rowSynapses[] = {16, 64, 128, 170};
+  const double postRates[] = {0.01, 0.05, 0.2};
+
+  for(const double postRate : postRates)
+  {
+    for(const unsigned int s : rowSynapses)
+    {
+      const Result result = Run<P, H, T>(s, postRate, plastic, numTicks);
+      printf("%7s %7u %10s %7u %8u %10.3f %16.0f %14.2f %12.1f %16.1f %16.2f\n",
+             plastic ? "yes" : "no", (unsigned int)(sizeof(P) * 8), format, T, s, postRate,
+             result.m_SynapticEventsPerSecond,
+             result.m_NanosecondsPerSynapse, result.m_NanosecondsPerRow,
+             result.m_WriteBackWordsPerRow, result.m_NanosecondsPerPostSpike);
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+template<template<typename, unsigned int> class H, unsigned int T>
+FlushResult RunFlush(double postRate, unsigned int flushPeriod, unsigned int numTicks)
+{
+  typedef ExtraModels::WeightAccumulator32 P;
+  typedef ExtraModels::RecurrentSTDP<uint16_t, P, ControlDelayBits, ControlIndexBits, MaxAxonalDelay,
+                                     NumPostNeurons, MaxRowSynapses,
+                                     TauALUTNumEntries, TauALUTShift, NumParamSets,
+                                     H, T, Common::Random::MarsKiss64> SynapseType;
+
+  // Load synapse type from synthetic plasticity region
+  std::unique_ptr<SynapseType> synapse(new SynapseType());
+  std::vector<uint32_t> region = BuildPlasticityRegion(1234, true);
+  synapse->ReadSDRAMData(region.data(), 0, 0);
+
+  // Build synthetic 'SDRAM' rows
+  std::mt19937 rng(5678);
+  std::vector<std::vector<uint32_t>> rows;
+  for(unsigned int r = 0; r < NumRows; r++)
+  {
+    rows.push_back(BuildRow<P>(*synapse, MaxRowSynapses, rng));
+  }
+
+  static uint32_t dmaBuffer[SynapseType::MaxRowWords];
+
+  std::bernoulli_distribution preSpikeDist(FlushPreRate);
+  std::bernoulli_distribution postSpikeDist(postRate);
+
+  auto applyInput = [](unsigned int tick, unsigned int index, int weight)
+  {
+    g_RingBuffer[((tick % NumRingBufferDelaySlots) * NumPostNeurons) + index] += weight;
+  };
+  auto addDelayRow = [](unsigned int, uint32_t, bool)
+  {
+    g_NumDelayRows++;
+  };
+  auto writeBackRow = [](uint32_t *sdramAddress, uint32_t *localAddress, unsigned int numWords)
+  {
+    memcpy(sdramAddress, localAddress, numWords * sizeof(uint32_t));
+  };
+
+  std::vector<unsigned int> rowLastProcessedTick(NumRows, 0);
+  for(unsigned int tick = 1; tick <= numTicks; tick++)
+  {
+    // Back-propagate spikes from post-synaptic neurons
+    for(unsigned int n = 0; n < NumPostNeurons; n++)
+    {
+      if(postSpikeDist(rng))
+      {
+        synapse->AddPostSynapticSpike(tick, n);
+      }
+    }
+
+    // Process rows which either spike or haven't
+    // been processed for the length of the flush period
+    for(unsigned int r = 0; r < NumRows; r++)
+    {
+      const bool spike = preSpikeDist(rng);
+      const bool flush = !spike && ((tick - rowLastProcessedTick[r]) >= flushPeriod);
+      if(spike || flush)
+      {
+        memcpy(dmaBuffer, rows[r].data(), rows[r].size() * sizeof(uint32_t));
+        synapse->ProcessRow(tick, dmaBuffer, rows[r].data(), flush,
+                            applyInput, addDelayRow, writeBackRow);
+        rowLastProcessedTick[r] = tick;
+      }
+    }
+  }
+
+  return FlushResult{synapse->GetNumFlushes(), synapse->GetNumTruncatedWindows()};
+}
+//-----------------------------------------------------------------------------
+template<typename SynapseType>
+void Simulate(SynapseType &synapse, std::vector<std::vector<uint32_t>> &rows,
+              std::vector<uint32_t> &ringBuffer, std::mt19937 &rng, double postRate,
+              unsigned int beginTick, unsigned int endTick)
+{
+  static uint32_t dmaBuffer[SynapseType::MaxRowWords];
+
+  std::bernoulli_distribution postSpikeDist(postRate);
+  std::uniform_int_distribution<unsigned int> rowDist(0, NumRows - 1);
+
+  auto applyInput = [&ringBuffer](unsigned int tick, unsigned int index, int weight)
+  {
+    ringBuffer[((tick % NumRingBufferDelaySlots) * NumPostNeurons) + index] += weight;
+  };
+  auto addDelayRow = [](unsigned int, uint32_t, bool)
+  {
+  };
+  auto writeBackRow = [](uint32_t *sdramAddress, uint32_t *localAddress, unsigned int numWords)
+  {
+    memcpy(sdramAddress, localAddress, numWords * sizeof(uint32_t));
+  };
+
+  for(unsigned int tick = beginTick; tick < endTick; tick++)
+  {
+    // Back-propagate spikes from post-synaptic neurons
+    for(unsigned int n = 0; n < NumPostNeurons; n++)
+    {
+      if(postSpikeDist(rng))
+      {
+        synapse.AddPostSynapticSpike(tick, n);
+      }
+    }
+
+    // 'DMA' and process random rows
+    for(unsigned int r = 0; r < RowsPerTick; r++)
+    {
+      auto &row = rows[rowDist(rng)];
+      memcpy(dmaBuffer, row.data(), row.size() * sizeof(uint32_t));
+      synapse.ProcessRow(tick, dmaBuffer, row.data(), false,
+                         applyInput, addDelayRow, writeBackRow);
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+template<typename P, template<typename, unsigned int> class H, unsigned int T>
+CheckpointResult RunCheckpoint(double postRate, unsigned int numTicks)
+{
+  typedef ExtraModels::RecurrentSTDP<uint16_t, P, ControlDelayBits, ControlIndexBits, MaxAxonalDelay,
+                                     NumPostNeurons, MaxRowSynapses,
+                                     TauALUTNumEntries, TauALUTShift, NumParamSets,
+                                     H, T, Common::Random::MarsKiss64> SynapseType;
+
+  // Load synapse type from synthetic plasticity region
+  std::unique_ptr<SynapseType> synapse(new SynapseType());
+  std::vector<uint32_t> region = BuildPlasticityRegion(1234, true);
+  synapse->ReadSDRAMData(region.data(), 0, 0);
+
+  // Build synthetic 'SDRAM' rows
+  std::mt19937 rng(5678);
+  std::vector<std::vector<uint32_t>> rows;
+  for(unsigned int r = 0; r < NumRows; r++)
+  {
+    rows.push_back(BuildRow<P>(*synapse, MaxRowSynapses, rng));
+  }
+
+  // Simulate first half of ticks - this is what restoring a checkpoint avoids replaying
+  std::vector<uint32_t> ringBuffer(NumRingBufferDelaySlots * NumPostNeurons, 0);
+  const unsigned int checkpointTick = 1 + (numTicks / 2);
+  const auto replayStart = std::chrono::high_resolution_clock::now();
+  Simulate(*synapse, rows, ringBuffer, rng, postRate, 1, checkpointTick);
+  const std::chrono::nanoseconds replayDuration = std::chrono::high_resolution_clock::now() - replayStart;
+
+  // Checkpoint learning state, the learning state held in each row and the spike source
+  std::vector<uint32_t> state(SynapseType::StateWords, 0);
+  unsigned int rowStateWords = 0;
+  for(const auto &row : rows)
+  {
+    rowStateWords += SynapseType::GetRowStateWords(row[0]);
+  }
+  std::vector<uint32_t> rowState(rowStateWords, 0);
+  const auto saveStart = std::chrono::high_resolution_clock::now();
+  synapse->WriteStateSDRAMData(state.data());
+  uint32_t *rowStateEnd = rowState.data();
+  for(const auto &row : rows)
+  {
+    SynapseType::WriteRowState(row.data(), rowStateEnd);
+  }
+  const std::chrono::nanoseconds saveDuration = std::chrono::high_resolution_clock::now() - saveStart;
+
+  // Load a fresh synapse type from the same region and rebuild the rows
+  // as they were before simulation, as the host would when reloading
+  std::unique_ptr<SynapseType> restoredSynapse(new SynapseType());
+  restoredSynapse->ReadSDRAMData(region.data(), 0, 0);
+  std::mt19937 restoredRowRNG(5678);
+  std::vector<std::vector<uint32_t>> restoredRows;
+  for(unsigned int r = 0; r < NumRows; r++)
+  {
+    restoredRows.push_back(BuildRow<P>(*restoredSynapse, MaxRowSynapses, restoredRowRNG));
+  }
+
+  // Restore checkpoint
+  // **NOTE** runtime/test checks that the restored state continues identically
+  const auto loadStart = std::chrono::high_resolution_clock::now();
+  restoredSynapse->ReadStateSDRAMData(state.data());
+  const uint32_t *rowStateBegin = rowState.data();
+  for(auto &row : restoredRows)
+  {
+    SynapseType::ReadRowState(row.data(), rowStateBegin);
+  }
+  const std::chrono::nanoseconds loadDuration = std::chrono::high_resolution_clock::now() - loadStart;
+
+  return CheckpointResult{(unsigned int)(SynapseType::StateWords * sizeof(uint32_t)),
+                          (unsigned int)(rowStateWords * sizeof(uint32_t)),
+                          (double)saveDuration.count() / 1000.0,
+                          (double)loadDuration.count() / 1000.0,
+                          (double)replayDuration.count() / 1000.0};
+}
+//-----------------------------------------------------------------------------
+template<typename P, template<typename, unsigned int> class H, unsigned int T>
+void PrintCheckpoint(const char *format, unsigned int numTicks)
+{
+  const CheckpointResult result = RunCheckpoint<P, H, T>(0.05, numTicks);
+  printf("%7u %10s %7u %12u %10u %10.2f %10.2f %12.1f\n",
+         (unsigned int)(sizeof(P) * 8), format, T, result.m_StateBytes, result.m_RowStateBytes,
+         result.m_SaveMicroseconds, result.m_LoadMicroseconds, result.m_ReplayMicroseconds);
+}
+//-----------------------------------------------------------------------------
+template<template<typename, unsigned int> class H, unsigned int T>
+void RunFlushSweep(const char *format, unsigned int numTicks)
+{
+  const unsigned int flushPeriods[] = {50, 100, 200, 400, 800};
+  const double postRates[] = {0.01, 0.05};
+
+  for(const double postRate : postRates)
+  {
+    for(const unsigned int f : flushPeriods)
+    {
+      const FlushResult result = RunFlush<H, T>(postRate, f, numTicks);
+      printf("%10s %7u %10.3f %12u %10u %17u\n",
+             format, T, postRate, f, result.m_NumFlushes,
+             result.m_NumTruncatedWindows);
+    }
+  }
+}
+} // Anonymous namespace
+
+//-----------------------------------------------------------------------------
+// Entry point
+//-----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  // Read number of ticks to simulate for each configuration
+  const unsigned int numTicks = (argc > 1) ? (unsigned int)atoi(argv[1]) : 2000;
+
+  // Report DTCM footprint of each build configuration
+  printf("%-16s %7s %7s %14s %18s %16s %12s\n",
+         "Build", "Neurons", "History", "Synapse bytes", "Ring-buffer bytes", "DMA buffer bytes", "Total bytes");
+  PrintFootprint<0, 256, 170, Wide, Standard, 10>("build", 3);
+  PrintFootprint<0, 256, 170, Wide, Compressed, 20>("build_compressed", 3);
+  PrintFootprint<0, 512, 170, Wide, Standard, 4>("build_wide", 3);
+  PrintFootprint<8, 128, 170, Wide, Standard, 24>("build_deep", 4);
+  PrintFootprint<0, 256, 256, Compact, Compressed, 20>("build_compact", 3);
+  printf("\n");
+
+  printf("%7s %7s %10s %7s %8s %10s %16s %14s %12s %16s %16s\n",
+         "Plastic", "Synapse", "Format", "History", "Synapses", "Post rate", "Events/s", "ns/synapse", "ns/row",
+         "Write-back words", "ns/post spike");
+
+  // Sweep over post-synaptic event history depths
+  RunSweep<Wide, Standard, 5>("standard", true, numTicks);
+  RunSweep<Wide, Standard, 10>("standard", true, numTicks);
+  RunSweep<Wide, Standard, 20>("standard", true, numTicks);
+
+  // Measure cost of compressed post-synaptic event history
+  RunSweep<Wide, Compressed, 20>("compressed", true, numTicks);
+
+  // Measure effect of packing plastic synapses into 16 bits
+  RunSweep<Compact, Compressed, 20>("compressed", true, numTicks);
+
+  // Measure static throughput with plasticity switched off
+  RunSweep<Wide, Standard, 10>("standard", false, numTicks);
+
+  // Compare flush events required by standard and compressed histories
+  // occupying similar amounts of DTCM to prevent windows being truncated
+  printf("\n%10s %7s %10s %12s %10s %17s\n",
+         "Format", "History", "Post rate", "Flush period", "Flushes", "Truncated windows");
+  RunFlushSweep<Standard, 10>("standard", numTicks);
+  RunFlushSweep<Compressed, 20>("compressed", numTicks);
+
+  // Compare the cost of restoring checkpointed learning state with replaying
+  printf("\n%7s %10s %7s %12s %10s %10s %10s %12s\n",
+         "Synapse", "Format", "History", "State bytes", "Row bytes",
+         "Save us", "Load us", "Replay us");
+  PrintCheckpoint<Wide, Standard, 10>("standard", numTicks);
+  PrintCheckpoint<Wide, Compressed, 20>("compressed", numTicks);
+  PrintCheckpoint<Compact, Compressed, 20>("compressed", numTicks);
+
+  // Prevent ring-buffer from being optimised away
+  uint32_t checksum = 0;
+  for(unsigned int i = 0; i < (NumRingBufferDelaySlots * NumPostNeurons); i++)
+  {
+    checksum += g_RingBuffer[i];
+  }
+  printf("Checksum:%u, delay rows:%u\n", checksum, g_NumDelayRows);
+  return 0;
+}
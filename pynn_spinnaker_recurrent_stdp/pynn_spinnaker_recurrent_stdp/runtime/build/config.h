@@ -15,15 +15,22 @@ namespace SynapseProcessor
 }
 
 // Recurrent STDP using 16-bit control words with 3 delay bits and 10 index bits;
-// 512 entry lookup table for accumulator decay a Mars Kiss 64 RNG
-// and a post-synaptic event history with 10 entries
+// 32-bit plastic synapses with 16-bit weights and accumulators;
+// no axonal delay;
+// 256 post-synaptic neurons; rows of up to 170 synapses;
+// a single parameter set with a 512 entry lookup table for accumulator decay
+// (sampled every 32 ticks);
+// a Mars Kiss 64 RNG and
+// a post-synaptic event history with 10 entries
 #include "common/random/mars_kiss64.h"
 #include "../recurrent_stdp.h"
 namespace SynapseProcessor
 {
-  typedef ExtraModels::RecurrentSTDP<uint16_t, 3, 10,
-                                     512, 0,
-                                     10, Common::Random::MarsKiss64> SynapseType;
+  typedef ExtraModels::RecurrentSTDP<uint16_t, ExtraModels::WeightAccumulator32, 3, 10, 0,
+                                     256, 170,
+                                     512, 5, 1,
+                                     SynapseProcessor::Plasticity::PostEventHistory, 10,
+                                     Common::Random::MarsKiss64> SynapseType;
 }
 
 
@@ -0,0 +1,50 @@
+#pragma once
+
+// Common includes
+#include "common/spike_input_buffer.h"
+namespace SynapseProcessor
+{
+  typedef Common::SpikeInputBufferBase<1024> SpikeInputBuffer;
+}
+
+// Synapse processor includes
+#include "synapse_processor/key_lookup_binary_search.h"
+namespace SynapseProcessor
+{
+  typedef KeyLookupBinarySearch<10> KeyLookup;
+}
+
+// Recurrent STDP using 16-bit control words with 3 delay bits and 10 index bits;
+// 32-bit plastic synapses with 16-bit weights and accumulators;
+// no axonal delay;
+// 256 post-synaptic neurons; rows of up to 170 synapses;
+// a single parameter set with a 512 entry lookup table for accumulator decay
+// (sampled every 32 ticks);
+// a Mars Kiss 64 RNG and
+// a compressed post-synaptic event history with 20 entries (in
+// roughly the same DTCM as a standard 10 entry history)
+#include "common/random/mars_kiss64.h"
+#include "../compressed_post_events.h"
+#include "../recurrent_stdp.h"
+namespace SynapseProcessor
+{
+  typedef ExtraModels::RecurrentSTDP<uint16_t, ExtraModels::WeightAccumulator32, 3, 10, 0,
+                                     256, 170,
+                                     512, 5, 1,
+                                     ExtraModels::CompressedPostEventHistory, 20,
+                                     Common::Random::MarsKiss64> SynapseType;
+}
+
+
+// Ring buffer with 32-bit unsigned entries, large enough for 256 neurons
+#include "synapse_processor/ring_buffer.h"
+namespace SynapseProcessor
+{
+  typedef RingBufferBase<uint32_t, 3, 8> RingBuffer;
+}
+
+#include "synapse_processor/delay_buffer.h"
+namespace SynapseProcessor
+{
+  typedef DelayBufferBase<10> DelayBuffer;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+// Common includes
+#include "common/spike_input_buffer.h"
+namespace SynapseProcessor
+{
+  typedef Common::SpikeInputBufferBase<1024> SpikeInputBuffer;
+}
+
+// Synapse processor includes
+#include "synapse_processor/key_lookup_binary_search.h"
+namespace SynapseProcessor
+{
+  typedef KeyLookupBinarySearch<10> KeyLookup;
+}
+
+// Recurrent STDP using 16-bit control words with 3 delay bits and 10 index bits;
+// 32-bit plastic synapses with 16-bit weights and accumulators;
+// up to 8 ticks of axonal delay;
+// 128 post-synaptic neurons; rows of up to 170 synapses;
+// a single parameter set with a 512 entry lookup table for accumulator decay
+// (sampled every 32 ticks);
+// a Mars Kiss 64 RNG and
+// a post-synaptic event history with 24 entries
+#include "common/random/mars_kiss64.h"
+#include "../recurrent_stdp.h"
+namespace SynapseProcessor
+{
+  typedef ExtraModels::RecurrentSTDP<uint16_t, ExtraModels::WeightAccumulator32, 3, 10, 8,
+                                     128, 170,
+                                     512, 5, 1,
+                                     SynapseProcessor::Plasticity::PostEventHistory, 24,
+                                     Common::Random::MarsKiss64> SynapseType;
+}
+
+
+// Ring buffer with 32-bit unsigned entries, large enough for 128 neurons
+// and 15 ticks of delay (7 dendritic and 8 axonal) - this occupies 8KB of
+// DTCM, the same as the 8 slot ring buffer of the 256 neuron default build
+#include "synapse_processor/ring_buffer.h"
+namespace SynapseProcessor
+{
+  typedef RingBufferBase<uint32_t, 4, 7> RingBuffer;
+}
+
+#include "synapse_processor/delay_buffer.h"
+namespace SynapseProcessor
+{
+  typedef DelayBufferBase<10> DelayBuffer;
+}
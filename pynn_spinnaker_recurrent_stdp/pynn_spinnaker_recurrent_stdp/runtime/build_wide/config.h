@@ -0,0 +1,48 @@
+#pragma once
+
+// Common includes
+#include "common/spike_input_buffer.h"
+namespace SynapseProcessor
+{
+  typedef Common::SpikeInputBufferBase<1024> SpikeInputBuffer;
+}
+
+// Synapse processor includes
+#include "synapse_processor/key_lookup_binary_search.h"
+namespace SynapseProcessor
+{
+  typedef KeyLookupBinarySearch<10> KeyLookup;
+}
+
+// Recurrent STDP using 16-bit control words with 3 delay bits and 10 index bits;
+// 32-bit plastic synapses with 16-bit weights and accumulators;
+// no axonal delay;
+// 512 post-synaptic neurons; rows of up to 170 synapses;
+// a single parameter set with a 512 entry lookup table for accumulator decay
+// (sampled every 32 ticks);
+// a Mars Kiss 64 RNG and
+// a post-synaptic event history with 4 entries
+#include "common/random/mars_kiss64.h"
+#include "../recurrent_stdp.h"
+namespace SynapseProcessor
+{
+  typedef ExtraModels::RecurrentSTDP<uint16_t, ExtraModels::WeightAccumulator32, 3, 10, 0,
+                                     512, 170,
+                                     512, 5, 1,
+                                     SynapseProcessor::Plasticity::PostEventHistory, 4,
+                                     Common::Random::MarsKiss64> SynapseType;
+}
+
+
+// Ring buffer with 32-bit unsigned entries, large enough for 512 neurons
+#include "synapse_processor/ring_buffer.h"
+namespace SynapseProcessor
+{
+  typedef RingBufferBase<uint32_t, 3, 9> RingBuffer;
+}
+
+#include "synapse_processor/delay_buffer.h"
+namespace SynapseProcessor
+{
+  typedef DelayBufferBase<10> DelayBuffer;
+}
@@ -0,0 +1,256 @@
+#pragma once
+
+// Standard includes
+#include <cstdint>
+#include <cstring>
+
+//-----------------------------------------------------------------------------
+// ExtraModels::CompressedPostEventHistory
+//-----------------------------------------------------------------------------
+// Drop-in replacement for SynapseProcessor::Plasticity::PostEventHistory
+// which, rather than storing a 32-bit time alongside each trace, stores the
+// time of the most recent event and an 8-bit offset from the previous event.
+// Offsets are stored plus one so that events in the same tick (offset zero)
+// can be distinguished from 'extension' entries (stored as zero) whose trace
+// holds the rest of an offset which doesn't fit into 8 bits. This allows
+// around twice as many events to be stored in the same amount of DTCM.
+namespace ExtraModels
+{
+template<typename T, unsigned int N>
+class CompressedPostEventHistory
+{
+private:
+  //-----------------------------------------------------------------------------
+  // Constants
+  //-----------------------------------------------------------------------------
+  // Largest offset which can be stored alongside an event
+  static const uint32_t MaxDelta = 254;
+  static const uint32_t MaxExtension = 65535;
+
+  static_assert(N < 256, "Compressed post event history can contain at most 255 entries");
+  static_assert(sizeof(T) >= 2, "Compressed post event history extension entries require 16-bit traces");
+
+public:
+  //-----------------------------------------------------------------------------
+  // Window
+  //-----------------------------------------------------------------------------
+  class Window
+  {
+  public:
+    Window(const uint8_t *deltas, const T *traces, unsigned int prevIndex,
+           uint32_t prevTime, unsigned int numEvents)
+      : m_Deltas(deltas), m_Traces(traces), m_PrevIndex(prevIndex), m_PrevTime(prevTime),
+        m_NumEvents(numEvents)
+    {
+      if(m_NumEvents > 0)
+      {
+        FindNext(prevTime);
+      }
+    }
+
+    //-----------------------------------------------------------------------------
+    // Public API
+    //-----------------------------------------------------------------------------
+    void Next(uint32_t delayedTime)
+    {
+      // Next event becomes previous
+      // **NOTE** like the standard history, the previous time is the
+      // delayed time the event was applied at, so the undelayed time
+      // is kept separately to decode the offset of the next event
+      const uint32_t prevEventTime = m_NextTime;
+      m_PrevIndex = m_NextIndex;
+      m_PrevTime = delayedTime;
+      m_NumEvents--;
+
+      // If there are any events remaining, find next one
+      if(m_NumEvents > 0)
+      {
+        FindNext(prevEventTime);
+      }
+    }
+
+    uint32_t GetNextTime() const{ return m_NextTime; }
+    T GetNextTrace() const{ return m_Traces[m_NextIndex]; }
+
+    uint32_t GetPrevTime() const{ return m_PrevTime; }
+    T GetPrevTrace() const{ return m_Traces[m_PrevIndex]; }
+
+    unsigned int GetNumEvents() const{ return m_NumEvents; }
+
+  private:
+    //-----------------------------------------------------------------------------
+    // Private methods
+    //-----------------------------------------------------------------------------
+    void FindNext(uint32_t prevEventTime)
+    {
+      // Add any extension entries following previous event to its time
+      uint32_t time = prevEventTime;
+      unsigned int i = m_PrevIndex + 1;
+      for(; m_Deltas[i] == 0; i++)
+      {
+        time += m_Traces[i];
+      }
+
+      // Add offset of next event
+      m_NextIndex = i;
+      m_NextTime = time + m_Deltas[i] - 1;
+    }
+
+    //-----------------------------------------------------------------------------
+    // Members
+    //-----------------------------------------------------------------------------
+    const uint8_t *m_Deltas;
+    const T *m_Traces;
+
+    unsigned int m_PrevIndex;
+    uint32_t m_PrevTime;
+
+    unsigned int m_NextIndex;
+    uint32_t m_NextTime;
+
+    unsigned int m_NumEvents;
+  };
+
+  CompressedPostEventHistory() : m_LastTime(0), m_Count(1)
+  {
+    // Start with a single event at time zero
+    m_Deltas[0] = EncodeDelta(0);
+    m_Traces[0] = T();
+  }
+
+  //-----------------------------------------------------------------------------
+  // Public API
+  //-----------------------------------------------------------------------------
+  Window GetWindow(uint32_t beginTime, uint32_t endTime) const
+  {
+    // Start at most recent event
+    unsigned int i = m_Count - 1;
+    uint32_t time = m_LastTime;
+
+    // Skip backwards over events after end of window
+    while(i > 0 && time > endTime)
+    {
+      i = GetPrevEvent(i, time);
+    }
+
+    // Count backwards through events after beginning of window
+    unsigned int numEvents = 0;
+    while(i > 0 && time > beginTime)
+    {
+      i = GetPrevEvent(i, time);
+      numEvents++;
+    }
+
+    return Window(m_Deltas, m_Traces, i, time, numEvents);
+  }
+
+  void Add(uint32_t time, T trace)
+  {
+    // Calculate how many entries are required to encode offset from last event
+    uint32_t delta = time - m_LastTime;
+    const unsigned int numEntries = 1 +
+      ((delta > MaxDelta) ? (((delta - MaxDelta) + (MaxExtension - 1)) / MaxExtension) : 0);
+
+    // If offset is too large to encode alongside even the most recent event,
+    // discard all events and add new event as the oldest in the history
+    // **NOTE** the offset of the oldest event is never used
+    if(numEntries >= N)
+    {
+      m_Count = 0;
+      delta = 0;
+    }
+    // Otherwise, evict oldest events until there is space
+    else
+    {
+      while((m_Count + numEntries) > N)
+      {
+        Evict();
+      }
+    }
+
+    // Add extension entries for any part of offset which doesn't fit into 8 bits
+    while(delta > MaxDelta)
+    {
+      const uint32_t extension = ((delta - MaxDelta) > MaxExtension) ? MaxExtension : (delta - MaxDelta);
+      m_Deltas[m_Count] = 0;
+      m_Traces[m_Count] = (T)extension;
+      m_Count++;
+      delta -= extension;
+    }
+
+    // Add event
+    m_Deltas[m_Count] = EncodeDelta(delta);
+    m_Traces[m_Count] = trace;
+    m_Count++;
+
+    m_LastTime = time;
+  }
+
+  uint32_t GetLastTime() const
+  {
+    return m_LastTime;
+  }
+
+  T GetLastTrace() const
+  {
+    return m_Traces[m_Count - 1];
+  }
+
+private:
+  //-----------------------------------------------------------------------------
+  // Private static methods
+  //-----------------------------------------------------------------------------
+  static uint8_t EncodeDelta(uint32_t delta)
+  {
+    return (uint8_t)(delta + 1);
+  }
+
+  //-----------------------------------------------------------------------------
+  // Private methods
+  //-----------------------------------------------------------------------------
+  unsigned int GetPrevEvent(unsigned int i, uint32_t &time) const
+  {
+    // Subtract offset of event
+    time -= (m_Deltas[i--] - 1);
+
+    // Subtract any extension entries
+    for(; m_Deltas[i] == 0; i--)
+    {
+      time -= m_Traces[i];
+    }
+
+    return i;
+  }
+
+  void Evict()
+  {
+    // Find next event after the oldest; skipping extension entries
+    // **NOTE** the offset of the oldest event is never used
+    unsigned int i = 1;
+    while(m_Deltas[i] == 0)
+    {
+      i++;
+    }
+
+    // Shift remaining entries down
+    m_Count -= i;
+    memmove(&m_Deltas[0], &m_Deltas[i], m_Count * sizeof(uint8_t));
+    memmove(&m_Traces[0], &m_Traces[i], m_Count * sizeof(T));
+  }
+
+  //-----------------------------------------------------------------------------
+  // Members
+  //-----------------------------------------------------------------------------
+  // Time of most recent event
+  uint32_t m_LastTime;
+
+  // Traces associated with each event (or extension of offset)
+  T m_Traces[N];
+
+  // Offset from previous event in ticks plus one (or zero for extension entries)
+  uint8_t m_Deltas[N];
+
+  // Number of entries
+  uint8_t m_Count;
+};
+} // ExtraModels
@@ -0,0 +1,352 @@
+#pragma once
+
+// Standard includes
+#include <cstdint>
+
+// Common includes
+#include "common/exp_decay_lut.h"
+#include "common/inverse_transform_sample_lut.h"
+#include "common/log.h"
+
+//-----------------------------------------------------------------------------
+// ExtraModels::LUTHeader
+//-----------------------------------------------------------------------------
+// Every lookup table is preceded in SDRAM by a two word header describing it:
+//   word 0: bits 0-15 number of entries, bits 16-23 shift, bits 24-31 type
+//   word 1: time constant or mean the table was generated from [ticks]
+// Tables baked into the binary are written with no entries so only the header
+// is read and its time constant is checked against the one baked in
+namespace ExtraModels
+{
+namespace LUTHeader
+{
+//-----------------------------------------------------------------------------
+// Enumerations
+//-----------------------------------------------------------------------------
+// **NOTE** these must match the LUT_TYPE constants in recurrent_stdp.py
+enum Type
+{
+  TypeExpDecay = 1,
+  TypeInverseTransformSample = 2,
+};
+
+//-----------------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------------
+inline uint32_t Build(Type type, unsigned int numEntries, unsigned int shift)
+{
+  return (type << 24) | (shift << 16) | numEntries;
+}
+
+inline bool Read(uint32_t *&region, Type type, unsigned int numEntries, unsigned int shift,
+                 uint32_t &timeConstant)
+{
+  // Read header words
+  const uint32_t layout = *region++;
+  timeConstant = *region++;
+
+  // If layout doesn't match the one this table was compiled with, give error
+  if(layout != Build(type, numEntries, shift))
+  {
+    LOG_PRINT(LOG_LEVEL_ERROR, "Lookup table type:%u, entries:%u, shift:%u does not match expected type:%u, entries:%u, shift:%u",
+              layout >> 24, layout & 0xFFFF, (layout >> 16) & 0xFF, type, numEntries, shift);
+    return false;
+  }
+
+  return true;
+}
+} // LUTHeader
+
+//-----------------------------------------------------------------------------
+// ExtraModels::LUTGeneration
+//-----------------------------------------------------------------------------
+// Compile-time generation of lookup tables using C++11 constexpr functions
+namespace LUTGeneration
+{
+//-----------------------------------------------------------------------------
+// Constants
+//-----------------------------------------------------------------------------
+constexpr double Ln2 = 0.693147180559945309417;
+
+//-----------------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------------
+// Round to nearest integer with halves rounded away from zero like std::round
+constexpr int32_t Round(double x)
+{
+  return (x < 0.0) ? -(int32_t)(0.5 - x) : (int32_t)(x + 0.5);
+}
+
+// Taylor series of e^x for x >= 0, summed until the terms become insignificant
+constexpr double ExpSeries(double x, unsigned int n, double term, double sum)
+{
+  return (term < (sum * 1.0E-17)) ? sum
+    : ExpSeries(x, n + 1, term * x / (double)(n + 1), sum + (term * x / (double)(n + 1)));
+}
+
+// e^-x for x >= 0 - beyond x = 64 the result is zero in any fixed-point format
+constexpr double ExpNeg(double x)
+{
+  return (x > 64.0) ? 0.0 : (1.0 / ExpSeries(x, 0, 1.0, 1.0));
+}
+
+// Series of atanh(z) = z + z^3/3 + z^5/5... given z^2 and z
+constexpr double AtanhSeries(double z2, double power, unsigned int k, double sum)
+{
+  return (power < 1.0E-17) ? sum
+    : AtanhSeries(z2, power * z2, k + 1, sum + (power / (double)((2 * k) + 1)));
+}
+
+// Natural log of x > 0, reducing x to [1, 2) and using ln(x) = 2 atanh((x - 1) / (x + 1))
+constexpr double Log(double x)
+{
+  return (x >= 2.0) ? (Ln2 + Log(x * 0.5))
+    : (x < 1.0) ? (Log(x * 2.0) - Ln2)
+    : (2.0 * AtanhSeries(((x - 1.0) / (x + 1.0)) * ((x - 1.0) / (x + 1.0)), (x - 1.0) / (x + 1.0), 0, 0.0));
+}
+
+//-----------------------------------------------------------------------------
+// Indices
+//-----------------------------------------------------------------------------
+// Sequence of indices 0 to N-1 built by concatenating two halves so the depth
+// of template recursion required is only logarithmic in the size of the table
+template<unsigned int... I>
+struct Indices
+{
+};
+
+template<typename A, typename B>
+struct ConcatIndices;
+
+template<unsigned int... A, unsigned int... B>
+struct ConcatIndices<Indices<A...>, Indices<B...>>
+{
+  typedef Indices<A..., (sizeof...(A) + B)...> Type;
+};
+
+template<unsigned int N>
+struct MakeIndices
+{
+  typedef typename ConcatIndices<typename MakeIndices<N / 2>::Type,
+                                 typename MakeIndices<N - (N / 2)>::Type>::Type Type;
+};
+
+template<>
+struct MakeIndices<0>
+{
+  typedef Indices<> Type;
+};
+
+template<>
+struct MakeIndices<1>
+{
+  typedef Indices<0> Type;
+};
+
+//-----------------------------------------------------------------------------
+// Table
+//-----------------------------------------------------------------------------
+// Table of values generated by G::Generate for each index in I
+template<typename G, typename I>
+struct Table;
+
+template<typename G, unsigned int... I>
+struct Table<G, Indices<I...>>
+{
+  static const typename G::Type s_Values[sizeof...(I)];
+};
+
+template<typename G, unsigned int... I>
+const typename G::Type Table<G, Indices<I...>>::s_Values[sizeof...(I)] = {G::Generate(I)...};
+
+//-----------------------------------------------------------------------------
+// ExpDecay
+//-----------------------------------------------------------------------------
+// Exponential decay in S2011 format sampled every 2^Shift ticks
+template<unsigned int Shift, unsigned int TauTicks>
+struct ExpDecay
+{
+  typedef int16_t Type;
+
+  static constexpr Type Generate(unsigned int i)
+  {
+    return (Type)Round(ExpNeg((double)(i << Shift) / (double)TauTicks) * 2048.0);
+  }
+};
+
+//-----------------------------------------------------------------------------
+// ExpDistInverseCDF
+//-----------------------------------------------------------------------------
+// Inverse CDF of exponential distribution sampled with IndexBits fractional bits of probability
+template<unsigned int IndexBits, typename T, unsigned int MeanTicks>
+struct ExpDistInverseCDF
+{
+  typedef T Type;
+
+  static constexpr Type Generate(unsigned int i)
+  {
+    return (Type)Round(-(double)MeanTicks * Log(1.0 - ((double)i / (double)(1u << IndexBits))));
+  }
+};
+} // LUTGeneration
+
+//-----------------------------------------------------------------------------
+// ExtraModels::ExpDecayLUT
+//-----------------------------------------------------------------------------
+// Exponential decay lookup table with a validated header. If BakedTauTicks is
+// non-zero, the table is generated at compile time and stored in the binary
+// rather than being read from SDRAM into DTCM
+template<unsigned int NumEntries, unsigned int Shift, unsigned int BakedTauTicks = 0>
+class ExpDecayLUT
+{
+private:
+  //-----------------------------------------------------------------------------
+  // Typedefines
+  //-----------------------------------------------------------------------------
+  typedef LUTGeneration::Table<LUTGeneration::ExpDecay<Shift, BakedTauTicks>,
+                               typename LUTGeneration::MakeIndices<NumEntries>::Type> Table;
+
+public:
+  //-----------------------------------------------------------------------------
+  // Public methods
+  //-----------------------------------------------------------------------------
+  int32_t Get(unsigned int i) const
+  {
+    const unsigned int j = (i >> Shift);
+    return (j < NumEntries) ? Table::s_Values[j] : 0;
+  }
+
+  bool ReadSDRAMData(uint32_t *&region)
+  {
+    // Baked tables are written with a header but no entries
+    uint32_t tauTicks;
+    if(!LUTHeader::Read(region, LUTHeader::TypeExpDecay, 0, Shift, tauTicks))
+    {
+      return false;
+    }
+
+    // If table was generated with a different time constant, give error
+    if(tauTicks != BakedTauTicks)
+    {
+      LOG_PRINT(LOG_LEVEL_ERROR, "Exponential decay time constant %u ticks does not match %u ticks baked into binary",
+                tauTicks, BakedTauTicks);
+      return false;
+    }
+
+    LOG_PRINT(LOG_LEVEL_INFO, "\tBaked exponential decay LUT: time constant:%u ticks", tauTicks);
+    return true;
+  }
+};
+
+template<unsigned int NumEntries, unsigned int Shift>
+class ExpDecayLUT<NumEntries, Shift, 0>
+{
+public:
+  //-----------------------------------------------------------------------------
+  // Public methods
+  //-----------------------------------------------------------------------------
+  int32_t Get(unsigned int i) const
+  {
+    return m_LUT.Get(i);
+  }
+
+  bool ReadSDRAMData(uint32_t *&region)
+  {
+    uint32_t tauTicks;
+    if(!LUTHeader::Read(region, LUTHeader::TypeExpDecay, NumEntries, Shift, tauTicks))
+    {
+      return false;
+    }
+
+    LOG_PRINT(LOG_LEVEL_INFO, "\tExponential decay LUT: time constant:%u ticks", tauTicks);
+    m_LUT.ReadSDRAMData(region);
+    return true;
+  }
+
+private:
+  //-----------------------------------------------------------------------------
+  // Members
+  //-----------------------------------------------------------------------------
+  Common::ExpDecayLUT<NumEntries, Shift> m_LUT;
+};
+
+//-----------------------------------------------------------------------------
+// ExtraModels::InverseTransformSampleLUT
+//-----------------------------------------------------------------------------
+// Inverse transform sampling lookup table for the exponential distribution
+// with a validated header. If BakedMeanTicks is non-zero, the table is
+// generated at compile time and stored in the binary rather than being
+// read from SDRAM into DTCM
+template<unsigned int IndexBits, typename T, typename R, typename RNG, unsigned int BakedMeanTicks = 0>
+class InverseTransformSampleLUT
+{
+private:
+  //-----------------------------------------------------------------------------
+  // Typedefines
+  //-----------------------------------------------------------------------------
+  typedef LUTGeneration::Table<LUTGeneration::ExpDistInverseCDF<IndexBits, T, BakedMeanTicks>,
+                               typename LUTGeneration::MakeIndices<1u << IndexBits>::Type> Table;
+
+public:
+  //-----------------------------------------------------------------------------
+  // Public methods
+  //-----------------------------------------------------------------------------
+  T Get(RNG &rng) const
+  {
+    return Table::s_Values[rng.GetNext() & ((1u << IndexBits) - 1)];
+  }
+
+  bool ReadSDRAMData(uint32_t *&region)
+  {
+    // Baked tables are written with a header but no entries
+    uint32_t meanTicks;
+    if(!LUTHeader::Read(region, LUTHeader::TypeInverseTransformSample, 0, 0, meanTicks))
+    {
+      return false;
+    }
+
+    // If table was generated with a different mean, give error
+    if(meanTicks != BakedMeanTicks)
+    {
+      LOG_PRINT(LOG_LEVEL_ERROR, "Exponential distribution mean %u ticks does not match %u ticks baked into binary",
+                meanTicks, BakedMeanTicks);
+      return false;
+    }
+
+    LOG_PRINT(LOG_LEVEL_INFO, "\tBaked inverse-CDF LUT: mean:%u ticks", meanTicks);
+    return true;
+  }
+};
+
+template<unsigned int IndexBits, typename T, typename R, typename RNG>
+class InverseTransformSampleLUT<IndexBits, T, R, RNG, 0>
+{
+public:
+  //-----------------------------------------------------------------------------
+  // Public methods
+  //-----------------------------------------------------------------------------
+  T Get(RNG &rng) const
+  {
+    return m_LUT.Get(rng);
+  }
+
+  bool ReadSDRAMData(uint32_t *&region)
+  {
+    uint32_t meanTicks;
+    if(!LUTHeader::Read(region, LUTHeader::TypeInverseTransformSample, 1u << IndexBits, 0, meanTicks))
+    {
+      return false;
+    }
+
+    LOG_PRINT(LOG_LEVEL_INFO, "\tInverse-CDF LUT: mean:%u ticks", meanTicks);
+    m_LUT.ReadSDRAMData(region);
+    return true;
+  }
+
+private:
+  //-----------------------------------------------------------------------------
+  // Members
+  //-----------------------------------------------------------------------------
+  Common::InverseTransformSampleLUT<IndexBits, T, R, RNG> m_LUT;
+};
+} // ExtraModels
@@ -0,0 +1,49 @@
+// Standard includes
+#include <cstdint>
+
+// Extra model includes
+#include "../weight_accumulator.h"
+
+// Matrix reader includes
+#include "matrix_reader.h"
+
+//-----------------------------------------------------------------------------
+// Anonymous namespace
+//-----------------------------------------------------------------------------
+namespace
+{
+//-----------------------------------------------------------------------------
+// Typedefines
+//-----------------------------------------------------------------------------
+// Control word type used by all RecurrentSTDP builds
+typedef uint16_t ControlWord;
+}
+
+//-----------------------------------------------------------------------------
+// C API
+//-----------------------------------------------------------------------------
+// Called from pynn_spinnaker_recurrent_stdp/matrix_reader.py using ctypes
+// **NOTE** returns 0 on success and -1 if any row is malformed
+extern "C" int decode_rows(const uint32_t *image, uint64_t imageWords,
+                           const uint64_t *rowOffsets, const uint32_t *rowPreIndices,
+                           const uint32_t *rowDelays, const uint64_t *synapseOffsets,
+                           uint32_t numRows, uint32_t indexBits, uint32_t delayBits,
+                           uint32_t postStart, uint32_t compact, uint32_t numThreads,
+                           uint32_t *pre, uint32_t *post, uint32_t *delay,
+                           int32_t *weight, int32_t *accumulator)
+{
+  using namespace ExtraModels;
+
+  const MatrixReader::Synapses synapses = {pre, post, delay, weight, accumulator};
+
+  // Decode rows using plastic synapse type matching build
+  const bool success = compact ?
+    MatrixReader::DecodeRowsParallel<WeightAccumulator16, ControlWord>(
+      image, imageWords, rowOffsets, rowPreIndices, rowDelays, synapseOffsets,
+      numRows, indexBits, delayBits, postStart, numThreads, synapses) :
+    MatrixReader::DecodeRowsParallel<WeightAccumulator32, ControlWord>(
+      image, imageWords, rowOffsets, rowPreIndices, rowDelays, synapseOffsets,
+      numRows, indexBits, delayBits, postStart, numThreads, synapses);
+
+  return success ? 0 : -1;
+}
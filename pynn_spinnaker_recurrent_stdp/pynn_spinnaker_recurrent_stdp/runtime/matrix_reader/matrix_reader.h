@@ -0,0 +1,182 @@
+#pragma once
+
+// Standard includes
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// ExtraModels::MatrixReader
+//-----------------------------------------------------------------------------
+// Host-side decoding of RecurrentSTDP rows read back from the
+// ExtendedPlasticSynapticMatrix region of a synapse processor
+namespace ExtraModels
+{
+namespace MatrixReader
+{
+//-----------------------------------------------------------------------------
+// Constants
+//-----------------------------------------------------------------------------
+// Synapse count, two delay extension words, time of last update, time of
+// last presynaptic spike and one word of pre-trace precede the plastic words
+// **NOTE** this must match RecurrentSTDP::GetPlasticWords in recurrent_stdp.h
+const unsigned int RowHeaderWords = 6;
+
+//-----------------------------------------------------------------------------
+// Synapses
+//-----------------------------------------------------------------------------
+// Arrays, with one element per synapse, into which rows are decoded
+struct Synapses
+{
+  uint32_t *m_Pre;
+  uint32_t *m_Post;
+  uint32_t *m_Delay;
+  int32_t *m_Weight;
+  int32_t *m_Accumulator;
+};
+
+//-----------------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------------
+template<typename T>
+unsigned int GetNumWords(unsigned int numSynapses)
+{
+  const unsigned int bytes = numSynapses * sizeof(T);
+  return (bytes / 4) + (((bytes % 4) == 0) ? 0 : 1);
+}
+
+// **NOTE** this must match RecurrentSTDP::GetRowWords in recurrent_stdp.h
+template<typename P, typename C>
+unsigned int GetRowWords(unsigned int numSynapses)
+{
+  return RowHeaderWords + GetNumWords<P>(numSynapses) + GetNumWords<C>(numSynapses);
+}
+
+// Decode rows [beginRow, endRow) of a memory image. The synapses of row r are
+// written to elements [synapseOffsets[r], synapseOffsets[r + 1]) of the
+// output arrays. Returns false if a row's synapse count doesn't match these
+// offsets or the row extends beyond the end of the image
+template<typename P, typename C>
+bool DecodeRows(const uint32_t *image, uint64_t imageWords,
+                const uint64_t *rowOffsets, const uint32_t *rowPreIndices,
+                const uint32_t *rowDelays, const uint64_t *synapseOffsets,
+                unsigned int beginRow, unsigned int endRow,
+                unsigned int indexBits, unsigned int delayBits, uint32_t postStart,
+                const Synapses &synapses)
+{
+  const uint32_t indexMask = (1u << indexBits) - 1;
+  const uint32_t delayMask = (1u << delayBits) - 1;
+
+  for(unsigned int r = beginRow; r < endRow; r++)
+  {
+    // Check row header is within image
+    const uint64_t rowOffset = rowOffsets[r];
+    if(rowOffset >= imageWords || (imageWords - rowOffset) < RowHeaderWords)
+    {
+      return false;
+    }
+
+    // Check synapse count matches output offsets and row is within image
+    const uint32_t *row = image + rowOffset;
+    const uint32_t numSynapses = row[0];
+    if(numSynapses != (synapseOffsets[r + 1] - synapseOffsets[r])
+      || (imageWords - rowOffset) < GetRowWords<P, C>(numSynapses))
+    {
+      return false;
+    }
+
+    // **NOTE** memcpy is used as a strict-aliasing-safe way
+    // of reading the plastic and control words from the image
+    const uint8_t *plasticBytes = reinterpret_cast<const uint8_t*>(row + RowHeaderWords);
+    const uint8_t *controlBytes = reinterpret_cast<const uint8_t*>(
+      row + RowHeaderWords + GetNumWords<P>(numSynapses));
+
+    const uint32_t pre = rowPreIndices[r];
+    const uint32_t rowDelay = rowDelays[r];
+    const uint64_t s = synapseOffsets[r];
+    for(unsigned int i = 0; i < numSynapses; i++)
+    {
+      P plasticWord;
+      memcpy(&plasticWord, plasticBytes + (i * sizeof(P)), sizeof(P));
+
+      C controlWord;
+      memcpy(&controlWord, controlBytes + (i * sizeof(C)), sizeof(C));
+
+      synapses.m_Pre[s + i] = pre;
+      synapses.m_Post[s + i] = postStart + (controlWord & indexMask);
+      synapses.m_Delay[s + i] = rowDelay + ((controlWord >> indexBits) & delayMask);
+      synapses.m_Weight[s + i] = plasticWord.GetWeight();
+
+      // **NOTE** accumulators are stored as 16-bit signed values but
+      // the runtime only sign-extends them when they are decayed
+      synapses.m_Accumulator[s + i] = (int16_t)plasticWord.GetAccumulator();
+    }
+  }
+
+  return true;
+}
+
+// Decode rows across numThreads threads, each of which
+// is given a contiguous block of rows containing a
+// similar number of synapses to keep them equally loaded
+template<typename P, typename C>
+bool DecodeRowsParallel(const uint32_t *image, uint64_t imageWords,
+                        const uint64_t *rowOffsets, const uint32_t *rowPreIndices,
+                        const uint32_t *rowDelays, const uint64_t *synapseOffsets,
+                        unsigned int numRows, unsigned int indexBits, unsigned int delayBits,
+                        uint32_t postStart, unsigned int numThreads, const Synapses &synapses)
+{
+  // If no thread count is specified, use one per hardware thread
+  if(numThreads == 0)
+  {
+    numThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  numThreads = std::max(1u, std::min(numThreads, numRows));
+
+  // If a single thread is required, decode on calling thread
+  if(numThreads == 1)
+  {
+    return DecodeRows<P, C>(image, imageWords, rowOffsets, rowPreIndices, rowDelays, synapseOffsets,
+                            0, numRows, indexBits, delayBits, postStart, synapses);
+  }
+
+  // Find row at which each thread should start
+  const uint64_t numSynapses = synapseOffsets[numRows];
+  std::vector<unsigned int> threadBeginRows(numThreads + 1, numRows);
+  threadBeginRows[0] = 0;
+  for(unsigned int t = 1; t < numThreads; t++)
+  {
+    const uint64_t targetSynapse = (numSynapses * t) / numThreads;
+    threadBeginRows[t] = (unsigned int)(std::lower_bound(synapseOffsets, synapseOffsets + numRows,
+                                                         targetSynapse) - synapseOffsets);
+  }
+
+  // Launch threads to decode each block of rows
+  // **NOTE** vector<bool> isn't safe to write from multiple threads
+  std::vector<uint8_t> threadSuccess(numThreads, 0);
+  std::vector<std::thread> threads;
+  threads.reserve(numThreads);
+  for(unsigned int t = 0; t < numThreads; t++)
+  {
+    threads.emplace_back(
+      [&, t]()
+      {
+        threadSuccess[t] = DecodeRows<P, C>(image, imageWords, rowOffsets, rowPreIndices, rowDelays,
+                                            synapseOffsets, threadBeginRows[t], threadBeginRows[t + 1],
+                                            indexBits, delayBits, postStart, synapses) ? 1 : 0;
+      });
+  }
+
+  // Wait for threads to complete
+  for(auto &t : threads)
+  {
+    t.join();
+  }
+
+  return std::all_of(threadSuccess.begin(), threadSuccess.end(),
+                     [](uint8_t s){ return s != 0; });
+}
+} // MatrixReader
+} // ExtraModels
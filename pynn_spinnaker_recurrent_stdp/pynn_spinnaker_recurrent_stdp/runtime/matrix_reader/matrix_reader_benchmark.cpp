@@ -0,0 +1,198 @@
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Extra model includes
+#include "../weight_accumulator.h"
+
+// Matrix reader includes
+#include "matrix_reader.h"
+
+// Namespaces
+using namespace ExtraModels;
+
+//-----------------------------------------------------------------------------
+// Anonymous namespace
+//-----------------------------------------------------------------------------
+namespace
+{
+//-----------------------------------------------------------------------------
+// Constants
+//-----------------------------------------------------------------------------
+// Control word layout matching build/config.h
+const unsigned int ControlDelayBits = 3;
+const unsigned int ControlIndexBits = 10;
+
+// Number of post-synaptic neurons handled by a synapse processor
+const unsigned int NumPostNeurons = 256;
+
+// Maximum number of synapses in a row
+const unsigned int MaxRowSynapses = 170;
+
+// Number of times each decode is timed (the fastest is reported)
+const unsigned int NumRepeats = 3;
+
+//-----------------------------------------------------------------------------
+// Typedefines
+//-----------------------------------------------------------------------------
+typedef uint16_t ControlWord;
+
+//-----------------------------------------------------------------------------
+// SynapseArrays
+//-----------------------------------------------------------------------------
+struct SynapseArrays
+{
+  SynapseArrays(uint64_t numSynapses)
+    : m_Pre(numSynapses), m_Post(numSynapses), m_Delay(numSynapses),
+      m_Weight(numSynapses), m_Accumulator(numSynapses)
+  {
+  }
+
+  MatrixReader::Synapses Get()
+  {
+    return {m_Pre.data(), m_Post.data(), m_Delay.data(), m_Weight.data(), m_Accumulator.data()};
+  }
+
+  bool operator == (const SynapseArrays &other) const
+  {
+    return (m_Pre == other.m_Pre && m_Post == other.m_Post && m_Delay == other.m_Delay
+      && m_Weight == other.m_Weight && m_Accumulator == other.m_Accumulator);
+  }
+
+  std::vector<uint32_t> m_Pre;
+  std::vector<uint32_t> m_Post;
+  std::vector<uint32_t> m_Delay;
+  std::vector<int32_t> m_Weight;
+  std::vector<int32_t> m_Accumulator;
+};
+
+//-----------------------------------------------------------------------------
+// MatrixImage
+//-----------------------------------------------------------------------------
+// Synthetic synaptic matrix region with rows of random length
+// laid out at a fixed stride as they are in SDRAM
+struct MatrixImage
+{
+  std::vector<uint32_t> m_Words;
+  std::vector<uint64_t> m_RowOffsets;
+  std::vector<uint32_t> m_RowPreIndices;
+  std::vector<uint32_t> m_RowDelays;
+  std::vector<uint64_t> m_SynapseOffsets;
+};
+
+template<typename P>
+MatrixImage BuildImage(unsigned int numRows, std::mt19937 &rng)
+{
+  std::uniform_int_distribution<unsigned int> rowSynapses(0, MaxRowSynapses);
+  std::uniform_int_distribution<unsigned int> postIndex(0, NumPostNeurons - 1);
+  std::uniform_int_distribution<unsigned int> delay(0, (1 << ControlDelayBits) - 1);
+  std::uniform_int_distribution<int32_t> weight(0, 0xFFFF);
+  std::uniform_int_distribution<int32_t> accumulator(-2048, 2047);
+
+  const unsigned int rowStride = MatrixReader::GetRowWords<P, ControlWord>(MaxRowSynapses);
+
+  MatrixImage image;
+  image.m_Words.resize((uint64_t)numRows * rowStride, 0);
+  image.m_SynapseOffsets.push_back(0);
+  for(unsigned int r = 0; r < numRows; r++)
+  {
+    const uint64_t rowOffset = (uint64_t)r * rowStride;
+    uint32_t *row = &image.m_Words[rowOffset];
+
+    // Write synapse count followed by plastic and control words
+    const unsigned int numSynapses = rowSynapses(rng);
+    row[0] = numSynapses;
+
+    P *plasticWords = reinterpret_cast<P*>(row + MatrixReader::RowHeaderWords);
+    ControlWord *controlWords = reinterpret_cast<ControlWord*>(
+      row + MatrixReader::RowHeaderWords + MatrixReader::GetNumWords<P>(numSynapses));
+    for(unsigned int i = 0; i < numSynapses; i++)
+    {
+      plasticWords[i] = P(weight(rng), accumulator(rng));
+      controlWords[i] = (ControlWord)(postIndex(rng) | (delay(rng) << ControlIndexBits));
+    }
+
+    image.m_RowOffsets.push_back(rowOffset);
+    image.m_RowPreIndices.push_back(r);
+    image.m_RowDelays.push_back(0);
+    image.m_SynapseOffsets.push_back(image.m_SynapseOffsets.back() + numSynapses);
+  }
+
+  return image;
+}
+
+template<typename P>
+double Decode(const MatrixImage &image, unsigned int numThreads, SynapseArrays &synapses)
+{
+  double bestSeconds = 0.0;
+  for(unsigned int i = 0; i < NumRepeats; i++)
+  {
+    const auto start = std::chrono::high_resolution_clock::now();
+    const bool success = MatrixReader::DecodeRowsParallel<P, ControlWord>(
+      image.m_Words.data(), image.m_Words.size(),
+      image.m_RowOffsets.data(), image.m_RowPreIndices.data(),
+      image.m_RowDelays.data(), image.m_SynapseOffsets.data(),
+      image.m_RowOffsets.size(), ControlIndexBits, ControlDelayBits, 0,
+      numThreads, synapses.Get());
+    const std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+
+    if(!success)
+    {
+      fprintf(stderr, "Decoding failed\n");
+      exit(1);
+    }
+
+    bestSeconds = (i == 0) ? duration.count() : std::min(bestSeconds, duration.count());
+  }
+  return bestSeconds;
+}
+
+template<typename P>
+void RunSweep(const char *format, unsigned int numRows, unsigned int maxThreads)
+{
+  std::mt19937 rng(1234);
+  const MatrixImage image = BuildImage<P>(numRows, rng);
+  const uint64_t numSynapses = image.m_SynapseOffsets.back();
+  const double imageMB = (double)(image.m_Words.size() * sizeof(uint32_t)) / (1024.0 * 1024.0);
+
+  // Decode on a single thread to provide reference
+  SynapseArrays reference(numSynapses);
+  const double referenceSeconds = Decode<P>(image, 1, reference);
+
+  // Decode using increasing numbers of threads
+  for(unsigned int t = 1; t <= maxThreads; t *= 2)
+  {
+    SynapseArrays synapses(numSynapses);
+    const double seconds = (t == 1) ? referenceSeconds : Decode<P>(image, t, synapses);
+    const bool identical = (t == 1) || (synapses == reference);
+
+    printf("%10s %10u %12lu %10.1f %7u %10.2f %14.1f %8.2f %10s\n",
+           format, numRows, (unsigned long)numSynapses, imageMB, t, seconds * 1000.0,
+           (double)numSynapses / (seconds * 1.0E6), referenceSeconds / seconds,
+           identical ? "yes" : "NO");
+  }
+}
+}
+
+//-----------------------------------------------------------------------------
+// Entry point
+//-----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  // Read number of rows to decode and maximum thread count
+  const unsigned int numRows = (argc > 1) ? (unsigned int)atoi(argv[1]) : 200000;
+  const unsigned int maxThreads = (argc > 2) ? (unsigned int)atoi(argv[2])
+    : std::max(1u, std::thread::hardware_concurrency());
+
+  printf("%10s %10s %12s %10s %7s %10s %14s %8s %10s\n",
+         "Format", "Rows", "Synapses", "Image MB", "Threads", "ms", "Msynapses/s", "Speedup", "Identical");
+  RunSweep<WeightAccumulator32>("wide", numRows, maxThreads);
+  RunSweep<WeightAccumulator16>("compact", numRows, maxThreads);
+  return 0;
+}
@@ -5,14 +5,17 @@
 #include <cstring>
 
 // Common includes
-#include "common/exp_decay_lut.h"
 #include "common/fixed_point_number.h"
-#include "common/inverse_transform_sample_lut.h"
 #include "common/log.h"
+#include "common/profiler.h"
 
 // Synapse processor includes
 #include "synapse_processor/plasticity/post_events.h"
 
+// Extra model includes
+#include "lookup_tables.h"
+#include "weight_accumulator.h"
+
 // Namespaces
 using namespace Common::FixedPointNumber;
 
@@ -21,35 +24,53 @@ using namespace Common::FixedPointNumber;
 //-----------------------------------------------------------------------------
 namespace ExtraModels
 {
-template<typename C, unsigned int D, unsigned int I,
-  unsigned int TauALUTNumEntries, unsigned int TauALUTShift,
-  unsigned int T,
-  typename RNG>
+template<typename C, typename P, unsigned int D, unsigned int I, unsigned int A,
+  unsigned int N, unsigned int S,
+  unsigned int TauALUTNumEntries, unsigned int TauALUTShift, unsigned int NumParamSets,
+  template<typename, unsigned int> class H, unsigned int T,
+  typename RNG,
+  unsigned int BakedTauATicks = 0, unsigned int BakedLambdaPreTicks = 0, unsigned int BakedLambdaPostTicks = 0>
 class RecurrentSTDP
 {
 private:
-  //-----------------------------------------------------------------------------
-  // Unions
-  //-----------------------------------------------------------------------------
-  union Pair
-  {
-    Pair(){}
-    Pair(uint16_t a, uint16_t b) : m_HalfWords{a, b} {}
-    Pair(uint32_t w) : m_Word(w) {}
-
-    uint16_t m_HalfWords[2];
-    uint32_t m_Word;
-  };
-
   //-----------------------------------------------------------------------------
   // Typedefines
   //-----------------------------------------------------------------------------
-  typedef Pair PlasticSynapse;
+  typedef P PlasticSynapse;
   typedef uint16_t Trace;
   typedef Trace PreTrace;
   typedef Trace PostTrace;
-  typedef SynapseProcessor::Plasticity::PostEventHistory<PostTrace, T> PostEventHistory;
-  typedef Common::InverseTransformSampleLUT<11, uint16_t, uint32_t, RNG> ExpDistLUT;
+  typedef H<PostTrace, T> PostEventHistory;
+  typedef InverseTransformSampleLUT<11, uint16_t, uint32_t, RNG, BakedLambdaPreTicks> PreExpDistLUT;
+  typedef InverseTransformSampleLUT<11, uint16_t, uint32_t, RNG, BakedLambdaPostTicks> PostExpDistLUT;
+
+  //-----------------------------------------------------------------------------
+  // ParamSet
+  //-----------------------------------------------------------------------------
+  // Plasticity parameters and lookup tables which can differ between rows
+  struct ParamSet
+  {
+    // Weight limits
+    int32_t m_MinWeight;
+    int32_t m_MaxWeight;
+
+    // Size of each weight update
+    S2011 m_A2Plus;
+    S2011 m_A2Minus;
+
+    // Size of each accumulator step
+    S2011 m_AccumulateIncrease;
+    S2011 m_AccumulateDecrease;
+
+    // Delay between presynaptic spikes being emitted and arriving at synapses
+    uint32_t m_AxonalDelay;
+
+    // Presynaptic inverse-CDF lookup table
+    PreExpDistLUT m_PreExpDistLUT;
+
+    // Exponential lookup tables
+    ExpDecayLUT<TauALUTNumEntries, TauALUTShift, BakedTauATicks> m_TauALUT;
+  };
 
   //-----------------------------------------------------------------------------
   // Constants
@@ -58,13 +79,90 @@ private:
   static const uint32_t DelayMask = ((1 << D) - 1);
   static const uint32_t IndexMask = ((1 << I) - 1);
 
+  static_assert((I + D) <= (sizeof(C) * 8), "Control word type too small for index and delay bits");
+  static_assert(N <= (1 << I), "Post-synaptic neurons cannot all be addressed with index bits");
+  static_assert((N % 32) == 0, "Post-synaptic neuron count must be a multiple of 32");
+  static_assert(NumParamSets > 0, "At least one parameter set is required");
+  static_assert(NumParamSets <= 0xFFFF, "Parameter set index must fit in upper half of pre-trace word");
+  static_assert(sizeof(PreTrace) == 2, "Parameter set index is stored in upper half of pre-trace word");
+
+  // Time of last update, time of last presynaptic spike and presynaptic
+  // trace are written back to SDRAM every time a row is updated
+  static const unsigned int HeaderWriteBackWords = 2 + PreTraceWords;
+
 public:
+  //-----------------------------------------------------------------------------
+  // Enumerations
+  //-----------------------------------------------------------------------------
+  // Tags used to profile phases of synapse processing. The per-synapse
+  // phases (window lookup, applying post-synaptic spikes, accumulator decay
+  // and applying presynaptic spikes) are only recorded for one synapse per
+  // row, with successive rows sampling successive synapse positions
+  // **NOTE** these start above the tags used by the synapse processor itself
+  // and must match those in pynn_spinnaker_recurrent_stdp/profiler.py
+  enum ProfilerTag
+  {
+    ProfilerTagUpdatePreTrace = 16,
+    ProfilerTagProcessSynapses,
+    ProfilerTagWindowLookup,
+    ProfilerTagApplyPostSpikes,
+    ProfilerTagAccumulatorDecay,
+    ProfilerTagApplyPreSpike,
+    ProfilerTagWriteBack,
+    ProfilerTagAddPostSynapticSpike,
+  };
+
+  // Counters of plasticity events, read using GetStatistic
+  enum Statistic
+  {
+    // Accumulator increases and decreases due to post-synaptic spikes
+    // within presynaptic windows and presynaptic spikes within post-synaptic windows
+    StatisticPotentiationEvents,
+    StatisticDepressionEvents,
+
+    // Accumulator reaching +-1 and being reset while updating the weight
+    StatisticAccumulatorResets,
+
+    // Synapse updates where events in the window since
+    // the last update had already overflowed from the history
+    StatisticPostHistoryOverflows,
+
+    // Flush events processed - these are required to prevent
+    // events overflowing from the post-synaptic histories
+    StatisticFlushRows,
+
+    // Synapse updates with no post-synaptic events in their window
+    StatisticEmptyWindowSynapses,
+
+    // Words written back to SDRAM
+    StatisticWriteBackWords,
+
+    StatisticMax,
+  };
+
   //-----------------------------------------------------------------------------
   // Constants
   //-----------------------------------------------------------------------------
-  // One word for a synapse-count, two delay words, a time of last update, 
-  // time and trace associated with last presynaptic spike and 512 synapses
-  static const unsigned int MaxRowWords = 256 + 5 + PreTraceWords;
+  // Version of learning state format - this should be incremented
+  // whenever the state written by WriteStateSDRAMData changes
+  static const uint32_t StateVersion = 4;
+
+  // RNG, post-synaptic event histories, times of
+  // last post-synaptic spikes and statistics
+  static const unsigned int StatePayloadWords = ((sizeof(RNG) + 3) / 4) +
+    (((N * sizeof(PostEventHistory)) + 3) / 4) + N + StatisticMax;
+
+  // Version, configuration fingerprint and size words followed by learning state
+  static const unsigned int StateWords = 3 + StatePayloadWords;
+
+  // Synapse count, time of last update, time and trace associated
+  // with last presynaptic spike and plastic words of a row's learning state
+  static const unsigned int RowStateHeaderWords = 3 + PreTraceWords;
+
+  // One word for a synapse-count, two delay words, a time of last update,
+  // time and trace associated with last presynaptic spike and S synapses
+  static const unsigned int MaxRowWords = 5 + PreTraceWords +
+    (((S * sizeof(PlasticSynapse)) + 3) / 4) + (((S * sizeof(C)) + 3) / 4);
 
   //-----------------------------------------------------------------------------
   // Public methods
@@ -76,12 +174,41 @@ public:
     LOG_PRINT(LOG_LEVEL_TRACE, "\tProcessing recurrent STDP row with %u synapses at tick:%u (flush:%u)",
               dmaBuffer[0], tick, flush);
 
+    // If this row's parameter set index is invalid, give error
+    // **NOTE** this is checked before anything is done with the row so
+    // neither it nor its delay extension are processed with the wrong set
+    const uint32_t paramSetIndex = GetParamSetIndex(dmaBuffer);
+    if(paramSetIndex >= NumParamSets)
+    {
+      LOG_PRINT(LOG_LEVEL_ERROR, "Invalid parameter set index:%u (%u parameter sets)",
+                paramSetIndex, NumParamSets);
+      return false;
+    }
+
     // If this row has a delay extension, call function to add it
     if(dmaBuffer[1] != 0)
     {
       addDelayRowFunction(dmaBuffer[1] + tick, dmaBuffer[2], flush);
     }
 
+    // Get parameter set used by this row
+    ParamSet &params = m_ParamSets[paramSetIndex];
+
+    // If plasticity is switched off at this tick
+    if(!IsPlasticityEnabled(tick))
+    {
+      // Flush events have nothing to update so can be skipped entirely,
+      // otherwise treat row as a static row. **NOTE** as neither the row
+      // header nor any synapses are written back, updates pending at the
+      // time plasticity was switched off are applied lazily by the first
+      // deferred update performed after it is switched back on
+      if(!flush)
+      {
+        ApplyStaticRow(tick, dmaBuffer, params, applyInputFunction);
+      }
+      return true;
+    }
+
     // Get time of last update from DMA buffer and write back updated time
     const uint32_t lastUpdateTick = dmaBuffer[3];
     dmaBuffer[3] = tick;
@@ -90,25 +217,52 @@ public:
     const uint32_t lastPreTick = dmaBuffer[4];
     const PreTrace lastPreTrace = GetPreTrace(dmaBuffer);
 
-    // If this is an actual spike (rather than a flush event)
+    // If this is a flush event, count it
     PreTrace newPreTrace;
-    if(!flush)
+    if(flush)
+    {
+      m_Statistics[StatisticFlushRows]++;
+    }
+    // Otherwise, this is an actual spike
+    else
     {
       LOG_PRINT(LOG_LEVEL_TRACE, "\t\tAdding pre-synaptic event to trace at tick:%u",
                 tick);
       // Calculate new pre-trace
+      Common::Profiler::WriteEntry(Common::Profiler::Enter | ProfilerTagUpdatePreTrace);
       newPreTrace = UpdateTrace(tick, lastPreTrace, lastPreTick,
-                                m_PreExpDistLUT);
+                                params.m_PreExpDistLUT);
+      Common::Profiler::WriteEntry(Common::Profiler::Exit | ProfilerTagUpdatePreTrace);
 
       // Write back updated last presynaptic spike time and trace to row
       dmaBuffer[4] = tick;
       SetPreTrace(dmaBuffer, newPreTrace);
     }
 
+    // Axonal delay is shared by all synapses in row
+    const uint32_t delayAxonal = params.m_AxonalDelay;
+
     // Extract first plastic and control words; and loop through synapses
     uint32_t count = dmaBuffer[0];
-    PlasticSynapse *plasticWords = GetPlasticWords(dmaBuffer);
+    PlasticSynapse *const firstPlasticWord = GetPlasticWords(dmaBuffer);
+    PlasticSynapse *plasticWords = firstPlasticWord;
     const C *controlWords = GetControlWords(dmaBuffer, count);
+
+    // Profiling every synapse would more than double the cost of processing
+    // them so only profile the phases of one synapse in each row. So the
+    // profile represents synapses at all positions, rather than those which
+    // benefit from the first being processed, successive rows rotate which
+    // synapse this is, wrapping back to the first if a row is too short
+    const uint32_t profiledSynapse = (m_NextProfiledSynapse < count) ? m_NextProfiledSynapse : 0;
+    m_NextProfiledSynapse = profiledSynapse + 1;
+    const PlasticSynapse *const profiledPlasticWord = firstPlasticWord + profiledSynapse;
+
+    // Span of plastic words modified by this update and
+    // whether any post-synaptic events have been processed
+    PlasticSynapse *dirtyBegin = nullptr;
+    PlasticSynapse *dirtyEnd = nullptr;
+    bool postEventsProcessed = false;
+    Common::Profiler::WriteEntry(Common::Profiler::Enter | ProfilerTagProcessSynapses);
     for(; count > 0; count--)
     {
       // Get the next control word from the synaptic_row
@@ -117,12 +271,14 @@ public:
 
       // Extract control word components
       const uint32_t delayDendritic = GetDelay(controlWord);
-      const uint32_t delayAxonal = 0;
       const uint32_t postIndex = GetIndex(controlWord);
 
+      // Determine whether this is the synapse being profiled in this row
+      const bool profile = (plasticWords == profiledPlasticWord);
+
       // Extract accumulator and weight components of plastic word
-      S2011 accumulator = (int32_t)plasticWords->m_HalfWords[1];
-      int32_t weight = (int32_t)plasticWords->m_HalfWords[0];
+      S2011 accumulator = plasticWords->GetAccumulator();
+      int32_t weight = plasticWords->GetWeight();
 
       // Apply axonal delay to last presynaptic spike and update tick
       const uint32_t delayedLastPreTick = lastPreTick + delayAxonal;
@@ -130,50 +286,107 @@ public:
 
       // Get the post-synaptic window of events to be processed
       // **NOTE** this is the window since the last UPDATE rather than the last presynaptic spike
-      const uint32_t windowBeginTick = (delayedLastUpdateTick >= delayDendritic) ?
-        (delayedLastUpdateTick - delayDendritic) : 0;
-      const uint32_t windowEndTick = tick + delayAxonal - delayDendritic;
-
-      // Get post event history within this window
-      auto postWindow = m_PostEventHistory[postIndex].GetWindow(windowBeginTick,
-                                                                windowEndTick);
+      // **NOTE** if the axonal delay is longer than the dendritic delay, post-synaptic
+      // spikes which will arrive at the synapse before the presynaptic spike may not
+      // have been emitted yet. The window therefore ends at the current tick and
+      // these spikes are processed, as if they coincided with it, at the next update
+      const uint32_t windowLag = (delayDendritic > delayAxonal) ? (delayDendritic - delayAxonal) : 0;
+      const uint32_t windowBeginTick = (lastUpdateTick >= windowLag) ?
+        (lastUpdateTick - windowLag) : 0;
+      const uint32_t windowEndTick = (tick >= windowLag) ? (tick - windowLag) : 0;
+
+      // Get time of last post-synaptic spike
+      WriteProfilerEntry(profile, Common::Profiler::Enter | ProfilerTagWindowLookup);
+      uint32_t lastPostTick = m_PostLastSpikeTick[postIndex];
+      PostTrace lastPostTrace;
+
+      // If post-synaptic neuron hasn't spiked since the start of the window,
+      // there are no events to process and its last spike is the previous event
+      if(lastPostTick < windowBeginTick)
+      {
+        LOG_PRINT(LOG_LEVEL_TRACE, "\t\tPerforming deferred synapse update for quiet post neuron:%u, last spike tick:%u",
+                  postIndex, lastPostTick);
 
-      LOG_PRINT(LOG_LEVEL_TRACE, "\t\tPerforming deferred synapse update for post neuron:%u", postIndex);
-      LOG_PRINT(LOG_LEVEL_TRACE, "\t\t\tWindow begin tick:%u, window end tick:%u: Previous time:%u, Num events:%u",
-          windowBeginTick, windowEndTick, postWindow.GetPrevTime(), postWindow.GetNumEvents());
+        m_Statistics[StatisticEmptyWindowSynapses]++;
 
-      // Process events in post-synaptic window
-      while (postWindow.GetNumEvents() > 0)
+        lastPostTrace = m_PostEventHistory[postIndex].GetLastTrace();
+        WriteProfilerEntry(profile, Common::Profiler::Exit | ProfilerTagWindowLookup);
+      }
+      // Otherwise
+      else
       {
-        const uint32_t delayedPostTick = postWindow.GetNextTime() + delayDendritic;
+        // Get post event history within this window
+        auto postWindow = m_PostEventHistory[postIndex].GetWindow(windowBeginTick,
+                                                                  windowEndTick);
 
-        // Decay accumulator from time of last update to time of this post-spike
-        accumulator = Mul16S2011(accumulator,
-                                 m_TauALUT.Get(delayedPostTick - delayedLastUpdateTick));
-        LOG_PRINT(LOG_LEVEL_TRACE, "\t\t\tDecaying accumulator over %u ticks to %d",
-                  delayedPostTick - delayedLastUpdateTick, accumulator);
+        LOG_PRINT(LOG_LEVEL_TRACE, "\t\tPerforming deferred synapse update for post neuron:%u", postIndex);
+        LOG_PRINT(LOG_LEVEL_TRACE, "\t\t\tWindow begin tick:%u, window end tick:%u: Previous time:%u, Num events:%u",
+            windowBeginTick, windowEndTick, postWindow.GetPrevTime(), postWindow.GetNumEvents());
 
-        LOG_PRINT(LOG_LEVEL_TRACE, "\t\t\tApplying post-synaptic event at delayed tick:%u",
-                  delayedPostTick);
+        // If the oldest event remaining in the history is within the window,
+        // earlier events in the window have overflowed from the history
+        if(postWindow.GetPrevTime() > windowBeginTick)
+        {
+          m_Statistics[StatisticPostHistoryOverflows]++;
+        }
 
-        // Apply post spike to synapse
-        ApplyPostSpike(delayedPostTick,
-                       delayedLastPreTick, lastPreTrace,
-                       accumulator, weight);
+        // If there are no events in the window, count empty window
+        if(postWindow.GetNumEvents() == 0)
+        {
+          m_Statistics[StatisticEmptyWindowSynapses]++;
+        }
+        WriteProfilerEntry(profile, Common::Profiler::Exit | ProfilerTagWindowLookup);
 
-        // Update time of last update
-        delayedLastUpdateTick = delayedPostTick;
+        // Process events in post-synaptic window
+        // **NOTE** this includes decaying the accumulator between events
+        WriteProfilerEntry(profile, Common::Profiler::Enter | ProfilerTagApplyPostSpikes);
+        while (postWindow.GetNumEvents() > 0)
+        {
+          uint32_t delayedPostTick = postWindow.GetNextTime() + delayDendritic;
+
+          // If post-synaptic spike arrived before the presynaptic spike
+          // applied at the last update, treat them as coinciding
+          if(delayedPostTick < delayedLastUpdateTick)
+          {
+            delayedPostTick = delayedLastUpdateTick;
+          }
+
+          // Decay accumulator from time of last update to time of this post-spike
+          accumulator = Mul16S2011(accumulator,
+                                   params.m_TauALUT.Get(delayedPostTick - delayedLastUpdateTick));
+          LOG_PRINT(LOG_LEVEL_TRACE, "\t\t\tDecaying accumulator over %u ticks to %d",
+                    delayedPostTick - delayedLastUpdateTick, accumulator);
+
+          LOG_PRINT(LOG_LEVEL_TRACE, "\t\t\tApplying post-synaptic event at delayed tick:%u",
+                    delayedPostTick);
+
+          // Apply post spike to synapse
+          ApplyPostSpike(params, delayedPostTick,
+                         delayedLastPreTick, lastPreTrace,
+                         accumulator, weight);
+
+          // Update time of last update
+          delayedLastUpdateTick = delayedPostTick;
+          postEventsProcessed = true;
+
+          // Go onto next event
+          postWindow.Next(delayedPostTick);
+        }
+        WriteProfilerEntry(profile, Common::Profiler::Exit | ProfilerTagApplyPostSpikes);
 
-        // Go onto next event
-        postWindow.Next(delayedPostTick);
+        // Get previous event from window
+        lastPostTick = postWindow.GetPrevTime();
+        lastPostTrace = postWindow.GetPrevTrace();
       }
 
       // Calculate time of update including axonal delay
       const uint32_t delayedUpdateTick = tick + delayAxonal;
 
       // Decay accumulator from time of last update to time of update
+      WriteProfilerEntry(profile, Common::Profiler::Enter | ProfilerTagAccumulatorDecay);
       accumulator = Mul16S2011(accumulator,
-                               m_TauALUT.Get(delayedUpdateTick - delayedLastUpdateTick));
+                               params.m_TauALUT.Get(delayedUpdateTick - delayedLastUpdateTick));
+      WriteProfilerEntry(profile, Common::Profiler::Exit | ProfilerTagAccumulatorDecay);
       LOG_PRINT(LOG_LEVEL_TRACE, "\t\t\tDecaying accumulator over %u ticks to %d",
                 delayedUpdateTick - delayedLastUpdateTick, accumulator);
 
@@ -181,36 +394,92 @@ public:
       if(!flush)
       {
         LOG_PRINT(LOG_LEVEL_TRACE, "\t\t\tApplying pre-synaptic event at tick:%u, last post tick:%u",
-                  delayedUpdateTick, postWindow.GetPrevTime());
+                  delayedUpdateTick, lastPostTick);
 
         // Apply pre-synaptic spike to synapse
-        ApplyPreSpike(delayedUpdateTick,
-                     postWindow.GetPrevTime(), postWindow.GetPrevTrace(),
+        WriteProfilerEntry(profile, Common::Profiler::Enter | ProfilerTagApplyPreSpike);
+        ApplyPreSpike(params, delayedUpdateTick,
+                     lastPostTick, lastPostTrace,
                      accumulator, weight);
+        WriteProfilerEntry(profile, Common::Profiler::Exit | ProfilerTagApplyPreSpike);
       }
 
+      // Convert updated weight and accumulator back into synaptic word
+      const PlasticSynapse updatedWord(weight, accumulator);
+
       // If this isn't a flush, add weight to ring-buffer
       if(!flush)
       {
         applyInputFunction(delayDendritic + delayAxonal + tick,
-          postIndex, weight);
+          postIndex, updatedWord.GetInputWeight());
       }
 
-      // Write back updated synaptic word to plastic region
-      *plasticWords++ = Pair((uint16_t)weight, (uint16_t)accumulator);
+      // If synaptic word has changed, write it back to plastic
+      // region and extend span of words requiring write back
+      if(updatedWord != *plasticWords)
+      {
+        *plasticWords = updatedWord;
+        if(dirtyBegin == nullptr)
+        {
+          dirtyBegin = plasticWords;
+        }
+        dirtyEnd = plasticWords + 1;
+      }
+      plasticWords++;
+    }
+    Common::Profiler::WriteEntry(Common::Profiler::Exit | ProfilerTagProcessSynapses);
+
+    // If this is a flush event and no post-synaptic events fell into any
+    // synapse's window, the only change is the accumulator decay. As this
+    // is re-applied from the unchanged time of last update the next time
+    // the row is processed, there is no need to write anything back
+    if(flush && !postEventsProcessed)
+    {
+      LOG_PRINT(LOG_LEVEL_TRACE, "\t\tSkipping write back of unchanged row");
+      return true;
+    }
+
+    // If no synaptic words have changed, write back just the row header
+    Common::Profiler::WriteEntry(Common::Profiler::Enter | ProfilerTagWriteBack);
+    if(dirtyBegin == nullptr)
+    {
+      WriteBack(&sdramRowAddress[3], &dmaBuffer[3],
+                HeaderWriteBackWords, writeBackRowFunction);
     }
+    // Otherwise
+    else
+    {
+      // Convert span of modified synapses into span of plastic words
+      const unsigned int dirtyBeginWord = ((dirtyBegin - firstPlasticWord) * sizeof(PlasticSynapse)) / 4;
+      const unsigned int dirtyEndWord = GetNumPlasticWords(dirtyEnd - firstPlasticWord);
 
-    // Write back row and all plastic data to SDRAM
-    writeBackRowFunction(&sdramRowAddress[3], &dmaBuffer[3],
-      2 + PreTraceWords + GetNumPlasticWords(dmaBuffer[0]));
+      // If dirty span starts at first plastic word, write back
+      // row header and dirty span of plastic words together
+      if(dirtyBeginWord == 0)
+      {
+        WriteBack(&sdramRowAddress[3], &dmaBuffer[3],
+                  HeaderWriteBackWords + dirtyEndWord, writeBackRowFunction);
+      }
+      // Otherwise write back header and dirty span separately
+      else
+      {
+        const unsigned int dirtyBeginOffset = 3 + HeaderWriteBackWords + dirtyBeginWord;
+        WriteBack(&sdramRowAddress[3], &dmaBuffer[3],
+                  HeaderWriteBackWords, writeBackRowFunction);
+        WriteBack(&sdramRowAddress[dirtyBeginOffset], &dmaBuffer[dirtyBeginOffset],
+                  dirtyEndWord - dirtyBeginWord, writeBackRowFunction);
+      }
+    }
+    Common::Profiler::WriteEntry(Common::Profiler::Exit | ProfilerTagWriteBack);
     return true;
   }
 
   void AddPostSynapticSpike(uint tick, unsigned int neuronID)
   {
-    // If neuron ID is valid
-    if(neuronID < 256)
+    // If neuron ID is valid and plasticity is enabled
+    if(neuronID < N && IsPlasticityEnabled(tick))
     {
+      Common::Profiler::WriteEntry(Common::Profiler::Enter | ProfilerTagAddPostSynapticSpike);
       LOG_PRINT(LOG_LEVEL_TRACE, "Adding post-synaptic event to trace at tick:%u",
                 tick);
 
@@ -223,6 +492,10 @@ public:
                                     postHistory.GetLastTime(),
                                     m_PostExpDistLUT);
       postHistory.Add(tick, trace);
+
+      // Update neuron's last spike time
+      m_PostLastSpikeTick[neuronID] = tick;
+      Common::Profiler::WriteEntry(Common::Profiler::Exit | ProfilerTagAddPostSynapticSpike);
     }
   }
 
@@ -246,31 +519,217 @@ public:
     }
     m_RNG.SetState(seed);
 
-    // Read parameters
-    m_MinWeight = *reinterpret_cast<int32_t*>(region++);
-    m_MaxWeight = *reinterpret_cast<int32_t*>(region++);
-    m_A2Plus = *reinterpret_cast<S2011*>(region++);
-    m_A2Minus = *reinterpret_cast<S2011*>(region++);
-    m_AccumulateIncrease = *reinterpret_cast<S2011*>(region++);
-    m_AccumulateDecrease = *reinterpret_cast<S2011*>(region++);
+    // Begin configuration fingerprint with template arguments
+    m_ConfigFingerprint = GetTemplateFingerprint();
+
+    // Read range of ticks during which plasticity is switched off
+    m_PlasticityOffStartTick = *region++;
+    m_PlasticityOffEndTick = *region++;
+
+    // Start profiling from first synapse of each row
+    m_NextProfiledSynapse = 0;
 
-    LOG_PRINT(LOG_LEVEL_INFO, "\tMin weight:%d, Max weight:%d, A2+:%d, A2-:%d, Accumulator increase:%d, Accumulator decrease:%d",
-              m_MinWeight, m_MaxWeight, m_A2Plus, m_A2Minus, m_AccumulateIncrease, m_AccumulateDecrease);
+    LOG_PRINT(LOG_LEVEL_INFO, "\tPlasticity off start tick:%u, Plasticity off end tick:%u",
+              m_PlasticityOffStartTick, m_PlasticityOffEndTick);
 
-    // Read inverse-CDF lookup tables
-    m_PreExpDistLUT.ReadSDRAMData(region);
-    m_PostExpDistLUT.ReadSDRAMData(region);
+    // Read post-synaptic inverse-CDF lookup table
+    m_ConfigFingerprint = HashLUTHeader(m_ConfigFingerprint, region);
+    if(!m_PostExpDistLUT.ReadSDRAMData(region))
+    {
+      return false;
+    }
 
-    // ReadExponential lookup tables
-    m_TauALUT.ReadSDRAMData(region);
+    // Loop through parameter sets
+    for(unsigned int p = 0; p < NumParamSets; p++)
+    {
+      ParamSet &params = m_ParamSets[p];
+
+      // Read parameters
+      params.m_MinWeight = *reinterpret_cast<int32_t*>(region++);
+      params.m_MaxWeight = *reinterpret_cast<int32_t*>(region++);
+      params.m_A2Plus = *reinterpret_cast<S2011*>(region++);
+      params.m_A2Minus = *reinterpret_cast<S2011*>(region++);
+      params.m_AccumulateIncrease = *reinterpret_cast<S2011*>(region++);
+      params.m_AccumulateDecrease = *reinterpret_cast<S2011*>(region++);
+
+      LOG_PRINT(LOG_LEVEL_INFO, "\tParameter set %u: Min weight:%d, Max weight:%d, A2+:%d, A2-:%d, Accumulator increase:%d, Accumulator decrease:%d",
+                p, params.m_MinWeight, params.m_MaxWeight, params.m_A2Plus, params.m_A2Minus,
+                params.m_AccumulateIncrease, params.m_AccumulateDecrease);
+
+      // Read axonal delay
+      params.m_AxonalDelay = *region++;
+
+      LOG_PRINT(LOG_LEVEL_INFO, "\tParameter set %u: Axonal delay:%u ticks",
+                p, params.m_AxonalDelay);
+
+      // If axonal delay is longer than ring-buffer can accommodate, give error
+      if(params.m_AxonalDelay > A)
+      {
+        LOG_PRINT(LOG_LEVEL_ERROR, "Axonal delay %u exceeds maximum of %u",
+                  params.m_AxonalDelay, A);
+        return false;
+      }
+
+      // Read presynaptic inverse-CDF lookup table
+      m_ConfigFingerprint = HashLUTHeader(m_ConfigFingerprint, region);
+      if(!params.m_PreExpDistLUT.ReadSDRAMData(region))
+      {
+        return false;
+      }
+
+      // Read exponential lookup tables
+      m_ConfigFingerprint = HashLUTHeader(m_ConfigFingerprint, region);
+      if(!params.m_TauALUT.ReadSDRAMData(region))
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  unsigned int GetNumFlushes() const
+  {
+    return m_Statistics[StatisticFlushRows];
+  }
+
+  unsigned int GetNumTruncatedWindows() const
+  {
+    return m_Statistics[StatisticPostHistoryOverflows];
+  }
+
+  uint32_t GetStatistic(Statistic statistic) const
+  {
+    return m_Statistics[statistic];
+  }
+
+  void WriteStateSDRAMData(uint32_t *region) const
+  {
+    LOG_PRINT(LOG_LEVEL_INFO, "ExtraModels::RecurrentSTDP::WriteStateSDRAMData");
+
+    // Write version, configuration fingerprint and size of learning state
+    *region++ = StateVersion;
+    *region++ = m_ConfigFingerprint;
+    *region++ = StatePayloadWords;
+
+    // Write learning state
+    // **NOTE** the learning state stored in the plastic rows is
+    // checkpointed separately from SDRAM using WriteRowState
+    WriteState(region, m_RNG);
+    WriteState(region, m_PostEventHistory);
+    WriteState(region, m_PostLastSpikeTick);
+    WriteState(region, m_Statistics);
+  }
+
+  bool ReadStateSDRAMData(const uint32_t *region)
+  {
+    LOG_PRINT(LOG_LEVEL_INFO, "ExtraModels::RecurrentSTDP::ReadStateSDRAMData");
+
+    // Read version, configuration fingerprint and size of learning state
+    const uint32_t version = *region++;
+    const uint32_t fingerprint = *region++;
+    const uint32_t payloadWords = *region++;
+
+    // If state was written by a different version or configuration, give error
+    // **NOTE** the fingerprint catches configurations whose state is the
+    // same size but would be misinterpreted e.g. different time constants
+    if(version != StateVersion || fingerprint != m_ConfigFingerprint
+      || payloadWords != StatePayloadWords)
+    {
+      LOG_PRINT(LOG_LEVEL_ERROR, "Learning state version:%u, fingerprint:%08x with %u words incompatible with version:%u, fingerprint:%08x with %u words",
+                version, fingerprint, payloadWords, StateVersion, m_ConfigFingerprint, StatePayloadWords);
+      return false;
+    }
+
+    // Read learning state
+    // **NOTE** this should be called after ReadSDRAMData as that calculates the fingerprint
+    ReadState(region, m_RNG);
+    ReadState(region, m_PostEventHistory);
+    ReadState(region, m_PostLastSpikeTick);
+    ReadState(region, m_Statistics);
 
     return true;
   }
 
+  static unsigned int GetRowStateWords(unsigned int numSynapses)
+  {
+    return RowStateHeaderWords + GetNumPlasticWords(numSynapses);
+  }
+
+  static void WriteRowState(const uint32_t *row, uint32_t *&region)
+  {
+    // Write synapse count, time of last update, time and
+    // trace of last presynaptic spike and plastic words
+    // **NOTE** delay extension and control words are
+    // structure rather than learning state so are skipped
+    const uint32_t numSynapses = row[0];
+    *region++ = numSynapses;
+    memcpy(region, &row[3], (2 + PreTraceWords) * sizeof(uint32_t));
+    region += 2 + PreTraceWords;
+    memcpy(region, &row[5 + PreTraceWords], GetNumPlasticWords(numSynapses) * sizeof(uint32_t));
+    region += GetNumPlasticWords(numSynapses);
+  }
+
+  static bool ReadRowState(uint32_t *row, const uint32_t *&region)
+  {
+    // If state was written from a row with a different number of synapses, give error
+    const uint32_t numSynapses = *region++;
+    if(numSynapses != row[0])
+    {
+      LOG_PRINT(LOG_LEVEL_ERROR, "Row learning state with %u synapses incompatible with row of %u synapses",
+                numSynapses, row[0]);
+      return false;
+    }
+
+    // Read time of last update, time and trace
+    // of last presynaptic spike and plastic words
+    memcpy(&row[3], region, (2 + PreTraceWords) * sizeof(uint32_t));
+    region += 2 + PreTraceWords;
+    memcpy(&row[5 + PreTraceWords], region, GetNumPlasticWords(numSynapses) * sizeof(uint32_t));
+    region += GetNumPlasticWords(numSynapses);
+    return true;
+  }
+
 private:
   //-----------------------------------------------------------------------------
   // Private methods
   //-----------------------------------------------------------------------------
+  template<typename R>
+  void WriteBack(uint32_t *sdramAddress, uint32_t *localAddress, unsigned int numWords,
+                 R writeBackRowFunction)
+  {
+    m_Statistics[StatisticWriteBackWords] += numWords;
+    writeBackRowFunction(sdramAddress, localAddress, numWords);
+  }
+
+  bool IsPlasticityEnabled(uint32_t tick) const
+  {
+    return (tick < m_PlasticityOffStartTick || tick >= m_PlasticityOffEndTick);
+  }
+
+  template<typename F>
+  void ApplyStaticRow(uint32_t tick, uint32_t (&dmaBuffer)[MaxRowWords],
+                      const ParamSet &params, F applyInputFunction) const
+  {
+    LOG_PRINT(LOG_LEVEL_TRACE, "\t\tPlasticity off - applying row as static weights");
+
+    // Extract first plastic and control words; and loop through synapses
+    uint32_t count = dmaBuffer[0];
+    const PlasticSynapse *plasticWords = GetPlasticWords(dmaBuffer);
+    const C *controlWords = GetControlWords(dmaBuffer, count);
+    for(; count > 0; count--)
+    {
+      // Get the next control word from the synaptic_row
+      // (should autoincrement pointer in single instruction)
+      const uint32_t controlWord = *controlWords++;
+
+      // Add weight component of plastic word to ring-buffer
+      const int32_t weight = (plasticWords++)->GetInputWeight();
+      applyInputFunction(GetDelay(controlWord) + params.m_AxonalDelay + tick,
+                         GetIndex(controlWord), weight);
+    }
+  }
+
   template<typename Dist>
   PreTrace UpdateTrace(uint32_t tick, Trace lastTrace, uint32_t lastTick,
     const Dist &expDistLUT)
@@ -301,7 +760,7 @@ private:
     }
   }
 
-  void ApplyPreSpike(uint32_t time,
+  void ApplyPreSpike(const ParamSet &params, uint32_t time,
                      uint32_t lastPostTime, PostTrace lastPostTrace,
                      S2011 &accumulator, int32_t &weight)
   {
@@ -318,7 +777,8 @@ private:
       if (timeSinceLastPost < lastPostTrace)
       {
         // Apply accumulator increase
-        accumulator -= m_AccumulateDecrease;
+        accumulator -= params.m_AccumulateDecrease;
+        m_Statistics[StatisticDepressionEvents]++;
         LOG_PRINT(LOG_LEVEL_TRACE, "\t\t\t\t\tAccumulator = %d", accumulator);
 
         // If it's less than -1
@@ -328,16 +788,17 @@ private:
 
           // Reset accumulator
           accumulator = 0;
+          m_Statistics[StatisticAccumulatorResets]++;
 
           // Subtract depression
           // **NOTE** this will leave weight in dynamic weight fixed point format
-          weight -= Mul16S2011(weight - m_MinWeight, m_A2Minus);
+          weight -= Mul16S2011(weight - params.m_MinWeight, params.m_A2Minus);
         }
       }
     }
   }
 
-  void ApplyPostSpike(uint32_t time,
+  void ApplyPostSpike(const ParamSet &params, uint32_t time,
                       uint32_t lastPreTime, PreTrace lastPreTrace,
                       S2011 &accumulator, int32_t &weight)
   {
@@ -354,7 +815,8 @@ private:
       if (timeSinceLastPre < lastPreTrace)
       {
         // Apply accumulator increase
-        accumulator += m_AccumulateIncrease;
+        accumulator += params.m_AccumulateIncrease;
+        m_Statistics[StatisticPotentiationEvents]++;
         LOG_PRINT(LOG_LEVEL_TRACE, "\t\t\t\t\tAccumulator = %d", accumulator);
 
         // If it's greater than one
@@ -364,10 +826,11 @@ private:
 
           // Reset accumulator
           accumulator = 0;
+          m_Statistics[StatisticAccumulatorResets]++;
 
           // Add potentiation
           // **NOTE** this will leave weight in dynamic weight fixed point format
-          weight += Mul16S2011(m_MaxWeight - weight, m_A2Plus);
+          weight += Mul16S2011(params.m_MaxWeight - weight, params.m_A2Plus);
         }
       }
     }
@@ -398,6 +861,65 @@ private:
     return (controlBytes / 4) + (((controlBytes % 4) == 0) ? 0 : 1);
   }
 
+  static void WriteProfilerEntry(bool profile, uint32_t tag)
+  {
+    if(profile)
+    {
+      Common::Profiler::WriteEntry(tag);
+    }
+  }
+
+  // **NOTE** learning state is copied verbatim so it
+  // can only be restored by an identical configuration
+  static uint32_t Hash(uint32_t hash, uint32_t word)
+  {
+    // FNV-1a applied to whole words
+    return (hash ^ word) * 16777619u;
+  }
+
+  static uint32_t GetTemplateFingerprint()
+  {
+    // **NOTE** sizes of types are included as, where these are
+    // themselves templates, their arguments determine the state layout
+    const uint32_t words[] = {
+      sizeof(C), sizeof(PlasticSynapse), D, I, A, N, S,
+      TauALUTNumEntries, TauALUTShift, NumParamSets, sizeof(PostEventHistory), T,
+      sizeof(RNG), BakedTauATicks, BakedLambdaPreTicks, BakedLambdaPostTicks};
+
+    uint32_t hash = 2166136261u;
+    for(uint32_t word : words)
+    {
+      hash = Hash(hash, word);
+    }
+    return hash;
+  }
+
+  static uint32_t HashLUTHeader(uint32_t hash, const uint32_t *region)
+  {
+    // Type, shift and number of entries followed by time constant
+    return Hash(Hash(hash, region[0]), region[1]);
+  }
+
+  template<typename V>
+  static void WriteState(uint32_t *&region, const V &state)
+  {
+    memcpy(region, static_cast<const void*>(&state), sizeof(V));
+    region += (sizeof(V) + 3) / 4;
+  }
+
+  template<typename V>
+  static void ReadState(const uint32_t *&region, V &state)
+  {
+    memcpy(static_cast<void*>(&state), region, sizeof(V));
+    region += (sizeof(V) + 3) / 4;
+  }
+
+  static uint32_t GetParamSetIndex(const uint32_t (&dmaBuffer)[MaxRowWords])
+  {
+    // Index of parameter set is stored in upper half of pre-trace word
+    return dmaBuffer[5] >> 16;
+  }
+
   static PreTrace GetPreTrace(uint32_t (&dmaBuffer)[MaxRowWords])
   {
     // **NOTE** GCC will optimise this memcpy out it
@@ -430,26 +952,30 @@ private:
   // Random number generator
   RNG m_RNG;
 
-  // Weight limits
-  int32_t m_MinWeight;
-  int32_t m_MaxWeight;
+  // Range of ticks during which plasticity is switched off
+  uint32_t m_PlasticityOffStartTick;
+  uint32_t m_PlasticityOffEndTick;
 
-  // Size of each weight update
-  S2011 m_A2Plus;
-  S2011 m_A2Minus;
+  // Post-synaptic inverse-CDF lookup table
+  PostExpDistLUT m_PostExpDistLUT;
 
-  // Size of each accumulator step
-  S2011 m_AccumulateIncrease;
-  S2011 m_AccumulateDecrease;
+  // Parameter sets which rows can select between
+  ParamSet m_ParamSets[NumParamSets];
 
-  // Inverse-CDF lookup tables
-  ExpDistLUT m_PreExpDistLUT;
-  ExpDistLUT m_PostExpDistLUT;
+  // Event history
+  PostEventHistory m_PostEventHistory[N];
 
-  // Exponential lookup tables
-  Common::ExpDecayLUT<TauALUTNumEntries, TauALUTShift> m_TauALUT;
+  // Time of last spike emitted by each post-synaptic neuron
+  uint32_t m_PostLastSpikeTick[N];
 
-  // Event history
-  PostEventHistory m_PostEventHistory[256];
+  // Index of synapse whose phases should be profiled in next row processed
+  uint32_t m_NextProfiledSynapse;
+
+  // Hash of template arguments and lookup table headers
+  // used to reject learning state from other configurations
+  uint32_t m_ConfigFingerprint;
+
+  // Statistics counters
+  uint32_t m_Statistics[StatisticMax];
 };
 } // BCPNN
\ No newline at end of file
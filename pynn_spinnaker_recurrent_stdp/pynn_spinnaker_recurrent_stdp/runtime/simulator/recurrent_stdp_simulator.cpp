@@ -0,0 +1,955 @@
+// Standard includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Common includes
+#include "common/random/mars_kiss64.h"
+
+// Recurrent STDP includes
+#include "../recurrent_stdp.h"
+
+// Extra model includes
+// **NOTE** these rely on logging having already been included
+#include "ca2_adaptive.h"
+#include "dual_exp.h"
+
+//-----------------------------------------------------------------------------
+// Anonymous namespace
+//-----------------------------------------------------------------------------
+namespace
+{
+//-----------------------------------------------------------------------------
+// Constants
+//-----------------------------------------------------------------------------
+// Template arguments matching build/config.h
+// **NOTE** these are compile-time constants of the synapse type so,
+// unlike the network, timestep and sweep grid, can't be configured
+const unsigned int ControlDelayBits = 3;
+const unsigned int ControlIndexBits = 10;
+const unsigned int MaxAxonalDelay = 0;
+const unsigned int RingBufferDelayBits = 3;
+
+// Number of post-synaptic neurons handled by each partition
+const unsigned int NumPostNeurons = 256;
+
+// Maximum number of synapses in a row
+const unsigned int MaxRowSynapses = 170;
+
+// Number of delay slots in ring-buffer
+const unsigned int NumRingBufferDelaySlots = 1 << RingBufferDelayBits;
+
+// Longest delay which can be encoded in control words - longer delays
+// are implemented using delay extension rows processed this many
+// ticks after the row which precedes them
+const unsigned int MaxControlDelay = (1 << ControlDelayBits) - 1;
+
+// Number of fractional bits in ring-buffer weights (S2011) which
+// are converted to S1615 currents when they are applied to neurons
+const unsigned int WeightFixedPoint = 11;
+
+//-----------------------------------------------------------------------------
+// Typedefines
+//-----------------------------------------------------------------------------
+// Synapse type matching build/config.h
+typedef ExtraModels::WeightAccumulator32 PlasticSynapse;
+typedef ExtraModels::RecurrentSTDP<uint16_t, PlasticSynapse, ControlDelayBits, ControlIndexBits, MaxAxonalDelay,
+                                   NumPostNeurons, MaxRowSynapses,
+                                   512, 5, 1,
+                                   SynapseProcessor::Plasticity::PostEventHistory, 10,
+                                   Common::Random::MarsKiss64> SynapseType;
+
+typedef ExtraModels::CA2Adaptive Neuron;
+typedef ExtraModels::DualExp Synapse;
+
+//-----------------------------------------------------------------------------
+// Config
+//-----------------------------------------------------------------------------
+// Network, timestep and sweep grid, read from a configuration file and the
+// command line. Defaults match build/config.h and the PyNN defaults of
+// IF_curr_ca2_adaptive_exp, except where noted
+struct Config
+{
+  // Simulation timestep and duration [ms]
+  double m_Timestep = 1.0;
+  double m_Duration = 1000.0;
+
+  // Network structure and range of synaptic delays [ms]
+  unsigned int m_NumPartitions = 4;
+  double m_ConnectionProbability = 0.1;
+  double m_MinDelay = 1.0;
+  double m_MaxDelay = 7.0;
+
+  // Independent Poisson input to each neuron [Hz, nA]
+  double m_ExternalRate = 50.0;
+  double m_ExternalWeight = 2.5;
+
+  // Neuron parameters with a 2ms refractory period
+  double m_VThresh = -50.0;
+  double m_VReset = -65.0;
+  double m_VRest = -65.0;
+  double m_TauM = 20.0;
+  double m_CM = 1.0;
+  double m_TauRefrac = 2.0;
+  double m_IAlpha = 0.1;
+  double m_TauCa2 = 50.0;
+  double m_TauSynE = 5.0;
+
+  // Recurrent STDP parameters which are not swept
+  double m_MinWeight = 0.0;
+  double m_MaxWeight = 0.1;
+  double m_InitialMaxWeight = 0.05;
+  double m_APlus = 0.2;
+  double m_AMinus = 0.2;
+
+  // Values of swept recurrent STDP parameters - every combination is simulated
+  std::vector<double> m_AccumulatorIncrease{0.25, 0.5};
+  std::vector<double> m_AccumulatorDecrease{0.25, 0.5};
+  std::vector<double> m_LambdaPre{10.0, 20.0};
+  std::vector<double> m_LambdaPost{10.0, 20.0};
+  std::vector<double> m_TauA{50.0, 100.0};
+
+  // Number of sweep points to simulate in parallel (0 uses one per hardware
+  // thread) and number of threads to spread the partitions of each across
+  unsigned int m_NumPointThreads = 0;
+  unsigned int m_NumPartitionThreads = 1;
+
+  unsigned int GetNumTicks() const
+  {
+    return (unsigned int)std::round(m_Duration / m_Timestep);
+  }
+
+  unsigned int GetDelayTicks(double delay) const
+  {
+    return (unsigned int)std::round(delay / m_Timestep);
+  }
+
+  // Number of rows, each covering MaxControlDelay ticks, the
+  // synapses from a neuron are divided between by delay
+  unsigned int GetNumDelayStages() const
+  {
+    return (GetDelayTicks(m_MaxDelay) + MaxControlDelay - 1) / MaxControlDelay;
+  }
+};
+
+//-----------------------------------------------------------------------------
+// SweepPoint
+//-----------------------------------------------------------------------------
+struct SweepPoint
+{
+  double m_AccumulatorIncrease;
+  double m_AccumulatorDecrease;
+  double m_LambdaPre;
+  double m_LambdaPost;
+  double m_TauA;
+};
+
+//-----------------------------------------------------------------------------
+// RowStage
+//-----------------------------------------------------------------------------
+// Synapses from a neuron whose delays are within the range covered by one row
+struct RowStage
+{
+  std::vector<unsigned int> m_Indices;
+  std::vector<uint32_t> m_Weights;
+  std::vector<uint32_t> m_Delays;
+};
+
+//-----------------------------------------------------------------------------
+// Result
+//-----------------------------------------------------------------------------
+struct Result
+{
+  uint64_t m_NumSynapticEvents;
+  uint64_t m_NumSpikes;
+  double m_MeanWeight;
+  double m_Seconds;
+  uint32_t m_Checksum;
+  uint64_t m_Statistics[SynapseType::StatisticMax];
+};
+
+//-----------------------------------------------------------------------------
+// Partition
+//-----------------------------------------------------------------------------
+// A synapse processor and the neurons it provides input to,
+// simulated by a single thread at a time
+struct Partition
+{
+  std::unique_ptr<SynapseType> m_Synapse;
+
+  // Rows from every neuron in the network to neurons in this partition
+  // followed by the delay extension rows of any longer delays
+  std::vector<std::vector<uint32_t>> m_Rows;
+  uint32_t m_DMABuffer[SynapseType::MaxRowWords];
+
+  // Indices of delay extension rows to process, indexed by tick
+  std::vector<std::vector<uint32_t>> m_DelayRowQueue;
+
+  uint32_t m_RingBuffer[NumRingBufferDelaySlots * NumPostNeurons];
+
+  Neuron::MutableState m_NeuronMutableState[NumPostNeurons];
+  Synapse::MutableState m_SynapseMutableState[NumPostNeurons];
+
+  // Source of external Poisson input
+  std::mt19937 m_ExternalRNG;
+
+  // Indices of neurons which spiked in the current tick
+  std::vector<unsigned int> m_Spikes;
+
+  uint64_t m_NumSynapticEvents;
+};
+
+//-----------------------------------------------------------------------------
+// Barrier
+//-----------------------------------------------------------------------------
+class Barrier
+{
+public:
+  Barrier(unsigned int numThreads) : m_NumThreads(numThreads), m_NumWaiting(0), m_Generation(0)
+  {
+  }
+
+  //-----------------------------------------------------------------------------
+  // Public API
+  //-----------------------------------------------------------------------------
+  void Wait()
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+    // If this is the last thread to arrive, start next generation and release others
+    const unsigned int generation = m_Generation;
+    if(++m_NumWaiting == m_NumThreads)
+    {
+      m_Generation++;
+      m_NumWaiting = 0;
+      m_Condition.notify_all();
+    }
+    // Otherwise, wait for generation to change
+    else
+    {
+      m_Condition.wait(lock, [this, generation](){ return (generation != m_Generation); });
+    }
+  }
+
+private:
+  //-----------------------------------------------------------------------------
+  // Members
+  //-----------------------------------------------------------------------------
+  std::mutex m_Mutex;
+  std::condition_variable m_Condition;
+  const unsigned int m_NumThreads;
+  unsigned int m_NumWaiting;
+  unsigned int m_Generation;
+};
+
+//-----------------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------------
+int16_t ToS2011(double value)
+{
+  return (int16_t)std::round(value * 2048.0);
+}
+//-----------------------------------------------------------------------------
+S1615 ToS1615(double value)
+{
+  return (S1615)std::round(value * 32768.0);
+}
+//-----------------------------------------------------------------------------
+U032 ToU032(double value)
+{
+  return (U032)std::min(std::round(value * 4294967296.0), 4294967295.0);
+}
+//-----------------------------------------------------------------------------
+void WriteExpDistLUT(std::vector<uint32_t> &region, double mean)
+{
+  // Header describing table
+  region.push_back(ExtraModels::LUTHeader::Build(ExtraModels::LUTHeader::TypeInverseTransformSample, 2048, 0));
+  region.push_back((uint32_t)std::round(mean));
+
+  // Inverse CDF of exponential distribution
+  // sampled with 11 fractional bits of probability
+  std::vector<uint16_t> lut(2048);
+  for(unsigned int i = 0; i < 2048; i++)
+  {
+    const double p = (double)i / 2048.0;
+    lut[i] = (uint16_t)std::round(-mean * std::log(1.0 - p));
+  }
+
+  const size_t start = region.size();
+  region.resize(start + (lut.size() / 2));
+  memcpy(&region[start], lut.data(), lut.size() * sizeof(uint16_t));
+}
+//-----------------------------------------------------------------------------
+void WriteExpDecayLUT(std::vector<uint32_t> &region, double tau,
+                      unsigned int numEntries, unsigned int shift)
+{
+  // Header describing table
+  region.push_back(ExtraModels::LUTHeader::Build(ExtraModels::LUTHeader::TypeExpDecay, numEntries, shift));
+  region.push_back((uint32_t)std::round(tau));
+
+  // Exponential decay in S2011 format
+  std::vector<int16_t> lut(numEntries + (numEntries % 2));
+  for(unsigned int i = 0; i < numEntries; i++)
+  {
+    lut[i] = ToS2011(std::exp(-(double)(i << shift) / tau));
+  }
+
+  const size_t start = region.size();
+  region.resize(start + (lut.size() / 2));
+  memcpy(&region[start], lut.data(), lut.size() * sizeof(int16_t));
+}
+//-----------------------------------------------------------------------------
+std::vector<uint32_t> BuildPlasticityRegion(uint32_t seed, const Config &config, const SweepPoint &point)
+{
+  std::vector<uint32_t> region;
+
+  // RNG seed
+  std::mt19937 seedGenerator(seed);
+  for(unsigned int s = 0; s < Common::Random::MarsKiss64::StateSize; s++)
+  {
+    region.push_back(seedGenerator());
+  }
+
+  // Plasticity is never switched off
+  region.push_back(0);
+  region.push_back(0);
+
+  // Postsynaptic window length distribution
+  WriteExpDistLUT(region, point.m_LambdaPost / config.m_Timestep);
+
+  // Weight limits, weight update sizes and accumulator steps
+  region.push_back((uint32_t)(int32_t)ToS2011(config.m_MinWeight));
+  region.push_back((uint32_t)(int32_t)ToS2011(config.m_MaxWeight));
+  region.push_back((uint32_t)(int32_t)ToS2011(config.m_APlus));
+  region.push_back((uint32_t)(int32_t)ToS2011(config.m_AMinus));
+  region.push_back((uint32_t)(int32_t)ToS2011(point.m_AccumulatorIncrease));
+  region.push_back((uint32_t)(int32_t)ToS2011(point.m_AccumulatorDecrease));
+
+  // Axonal delay
+  region.push_back(0);
+
+  // Presynaptic window length distribution
+  WriteExpDistLUT(region, point.m_LambdaPre / config.m_Timestep);
+
+  // Accumulator decay
+  WriteExpDecayLUT(region, point.m_TauA / config.m_Timestep, 512, 5);
+  return region;
+}
+//-----------------------------------------------------------------------------
+std::vector<uint32_t> BuildRow(const SynapseType &synapse, const RowStage &stage)
+{
+  // Synapse count; no delay extension; last update, last pre-spike and trace all zero
+  const unsigned int rowSynapses = stage.m_Indices.size();
+  std::vector<uint32_t> row(synapse.GetRowWords(rowSynapses), 0);
+  row[0] = rowSynapses;
+
+  // Plastic synapses start after five header words and the pre-trace;
+  // the 16-bit control words follow them at the end of the row
+  const unsigned int controlWords = (rowSynapses + 1) / 2;
+  PlasticSynapse *plastic = reinterpret_cast<PlasticSynapse*>(&row[6]);
+  uint16_t *control = reinterpret_cast<uint16_t*>(&row[row.size() - controlWords]);
+  for(unsigned int s = 0; s < rowSynapses; s++)
+  {
+    // Weight and zero accumulator
+    plastic[s] = PlasticSynapse(stage.m_Weights[s], 0);
+
+    control[s] = (uint16_t)(stage.m_Indices[s] | (stage.m_Delays[s] << ControlIndexBits));
+  }
+
+  return row;
+}
+//-----------------------------------------------------------------------------
+std::vector<uint32_t> BuildRows(const Config &config, const SynapseType &synapse,
+                                unsigned int firstExtensionRow, std::mt19937 &rng,
+                                std::vector<std::vector<uint32_t>> &extensionRows)
+{
+  std::bernoulli_distribution connectionDist(config.m_ConnectionProbability);
+  std::uniform_int_distribution<uint32_t> weightDist(0, ToS2011(config.m_InitialMaxWeight));
+  std::uniform_int_distribution<uint32_t> delayDist(config.GetDelayTicks(config.m_MinDelay),
+                                                    config.GetDelayTicks(config.m_MaxDelay));
+
+  // Pick post-synaptic neurons this row connects to
+  std::vector<unsigned int> indices;
+  for(unsigned int n = 0; n < NumPostNeurons && indices.size() < MaxRowSynapses; n++)
+  {
+    if(connectionDist(rng))
+    {
+      indices.push_back(n);
+    }
+  }
+
+  // Pick random weight and delay for each synapse and divide synapses
+  // between stages, each covering MaxControlDelay ticks of delay
+  std::vector<RowStage> stages(config.GetNumDelayStages());
+  for(const unsigned int index : indices)
+  {
+    const uint32_t weight = weightDist(rng);
+    const uint32_t delay = delayDist(rng);
+    RowStage &stage = stages[(delay - 1) / MaxControlDelay];
+    stage.m_Indices.push_back(index);
+    stage.m_Weights.push_back(weight);
+    stage.m_Delays.push_back(delay - (((delay - 1) / MaxControlDelay) * MaxControlDelay));
+  }
+
+  // Build row for the first stage and delay extension rows for any later
+  // stages containing synapses, each of which is added by the previous row
+  std::vector<uint32_t> row = BuildRow(synapse, stages[0]);
+  unsigned int previousStage = 0;
+  for(unsigned int s = 1; s < stages.size(); s++)
+  {
+    if(!stages[s].m_Indices.empty())
+    {
+      std::vector<uint32_t> &previousRow = (previousStage == 0) ? row : extensionRows.back();
+      previousRow[1] = (s - previousStage) * MaxControlDelay;
+      previousRow[2] = firstExtensionRow + extensionRows.size();
+
+      extensionRows.push_back(BuildRow(synapse, stages[s]));
+      previousStage = s;
+    }
+  }
+
+  return row;
+}
+//-----------------------------------------------------------------------------
+void BuildPartition(Partition &partition, unsigned int p, const Config &config,
+                    const SweepPoint &point)
+{
+  // Load synapse type from plasticity region with a different seed for each partition
+  partition.m_Synapse.reset(new SynapseType());
+  std::vector<uint32_t> region = BuildPlasticityRegion(1234 + p, config, point);
+  partition.m_Synapse->ReadSDRAMData(region.data(), 0, 0);
+
+  // Build rows from every neuron in network followed by their delay extension rows
+  const unsigned int numNeurons = config.m_NumPartitions * NumPostNeurons;
+  std::mt19937 rng(5678 + p);
+  std::vector<std::vector<uint32_t>> extensionRows;
+  partition.m_Rows.clear();
+  for(unsigned int n = 0; n < numNeurons; n++)
+  {
+    partition.m_Rows.push_back(BuildRows(config, *partition.m_Synapse, numNeurons,
+                                         rng, extensionRows));
+  }
+  partition.m_Rows.insert(partition.m_Rows.end(), extensionRows.begin(), extensionRows.end());
+
+  // **NOTE** a delay extension row is never added more than the
+  // longest delay ahead so this many slots never wrap around
+  partition.m_DelayRowQueue.assign(config.GetNumDelayStages() * MaxControlDelay,
+                                   std::vector<uint32_t>());
+
+  // Neurons start at rest with no input
+  memset(partition.m_RingBuffer, 0, sizeof(partition.m_RingBuffer));
+  for(unsigned int n = 0; n < NumPostNeurons; n++)
+  {
+    partition.m_NeuronMutableState[n] = Neuron::MutableState{ToS1615(config.m_VRest), 0, 0};
+    partition.m_SynapseMutableState[n] = Synapse::MutableState{0, 0, 0};
+  }
+
+  partition.m_ExternalRNG.seed(9012 + p);
+  partition.m_Spikes.clear();
+  partition.m_NumSynapticEvents = 0;
+}
+//-----------------------------------------------------------------------------
+Neuron::ImmutableState GetNeuronImmutableState(const Config &config)
+{
+  const double timestep = config.m_Timestep;
+  return Neuron::ImmutableState{ToS1615(config.m_VThresh), ToS1615(config.m_VReset), ToS1615(config.m_VRest),
+                                ToS1615(0.0), ToS1615(config.m_TauM / config.m_CM),
+                                ToS1615(std::exp(-timestep / config.m_TauM)),
+                                (int32_t)std::round(config.m_TauRefrac / timestep),
+                                ToS1615(config.m_IAlpha), ToS1615(std::exp(-timestep / config.m_TauCa2))};
+}
+//-----------------------------------------------------------------------------
+Synapse::ImmutableState GetSynapseImmutableState(const Config &config)
+{
+  // Excitatory synapses
+  const double tau = config.m_TauSynE;
+  const double timestep = config.m_Timestep;
+  const U032 expTau = ToU032(std::exp(-timestep / tau));
+  const S1615 init = ToS1615((tau / timestep) * (1.0 - std::exp(-timestep / tau)));
+  return Synapse::ImmutableState{expTau, init, expTau, init, expTau, init};
+}
+//-----------------------------------------------------------------------------
+void SimulatePartition(Partition &partition, uint32_t tick, const std::vector<unsigned int> &spikes,
+                       const Config &config, const Neuron::ImmutableState &neuronImmutableState,
+                       const Synapse::ImmutableState &synapseImmutableState)
+{
+  uint32_t *ringBuffer = partition.m_RingBuffer;
+  auto &delayRowQueue = partition.m_DelayRowQueue;
+  auto applyInput = [ringBuffer](unsigned int tick, unsigned int index, int weight)
+  {
+    ringBuffer[((tick % NumRingBufferDelaySlots) * NumPostNeurons) + index] += weight;
+  };
+  auto addDelayRow = [&delayRowQueue](unsigned int tick, uint32_t row, bool)
+  {
+    delayRowQueue[tick % delayRowQueue.size()].push_back(row);
+  };
+  auto writeBackRow = [](uint32_t *sdramAddress, uint32_t *localAddress, unsigned int numWords)
+  {
+    memcpy(sdramAddress, localAddress, numWords * sizeof(uint32_t));
+  };
+  auto processRow = [&](uint32_t r)
+  {
+    auto &row = partition.m_Rows[r];
+    memcpy(partition.m_DMABuffer, row.data(), row.size() * sizeof(uint32_t));
+    partition.m_Synapse->ProcessRow(tick, partition.m_DMABuffer, row.data(), false,
+                                    applyInput, addDelayRow, writeBackRow);
+    partition.m_NumSynapticEvents += row[0];
+  };
+
+  // 'DMA' and process rows of neurons which spiked last tick
+  for(const unsigned int s : spikes)
+  {
+    processRow(s);
+  }
+
+  // Process delay extension rows added for this tick
+  // **NOTE** delay extension rows are always added to later ticks
+  // so this tick's queue isn't modified while it is processed
+  auto &delayRows = delayRowQueue[tick % delayRowQueue.size()];
+  for(const uint32_t r : delayRows)
+  {
+    processRow(r);
+  }
+  delayRows.clear();
+
+  // Update neurons using input from this tick's ring-buffer slot
+  const S1615 externalInput = ToS1615(config.m_ExternalWeight);
+  std::bernoulli_distribution externalDist(config.m_ExternalRate * config.m_Timestep / 1000.0);
+  uint32_t *tickRingBuffer = &ringBuffer[(tick % NumRingBufferDelaySlots) * NumPostNeurons];
+  partition.m_Spikes.clear();
+  for(unsigned int n = 0; n < NumPostNeurons; n++)
+  {
+    Neuron::MutableState &neuronMutableState = partition.m_NeuronMutableState[n];
+    Synapse::MutableState &synapseMutableState = partition.m_SynapseMutableState[n];
+
+    // Apply recurrent and external input to excitatory receptor
+    const S1615 input = (S1615)(tickRingBuffer[n] << (15 - WeightFixedPoint));
+    tickRingBuffer[n] = 0;
+    Synapse::ApplyInput(synapseMutableState, synapseImmutableState, input, 0);
+    if(externalDist(partition.m_ExternalRNG))
+    {
+      Synapse::ApplyInput(synapseMutableState, synapseImmutableState, externalInput, 0);
+    }
+
+    // Update neuron and back-propagate any spike to synapses
+    const S1615 excInput = Synapse::GetExcInput(synapseMutableState, synapseImmutableState);
+    const S1615 inhInput = Synapse::GetInhInput(synapseMutableState, synapseImmutableState);
+    if(Neuron::Update(neuronMutableState, neuronImmutableState, excInput, inhInput, 0))
+    {
+      partition.m_Spikes.push_back(n);
+      partition.m_Synapse->AddPostSynapticSpike(tick, n);
+    }
+
+    // Decay synaptic input
+    Synapse::Shape(synapseMutableState, synapseImmutableState);
+  }
+}
+//-----------------------------------------------------------------------------
+Result Simulate(const Config &config, const SweepPoint &point)
+{
+  const Neuron::ImmutableState neuronImmutableState = GetNeuronImmutableState(config);
+  const Synapse::ImmutableState synapseImmutableState = GetSynapseImmutableState(config);
+  const unsigned int numTicks = config.GetNumTicks();
+  const unsigned int numPartitions = config.m_NumPartitions;
+  const unsigned int numThreads = config.m_NumPartitionThreads;
+
+  // Build partitions
+  std::vector<Partition> partitions(numPartitions);
+  for(unsigned int p = 0; p < numPartitions; p++)
+  {
+    BuildPartition(partitions[p], p, config, point);
+  }
+
+  // Spikes emitted by whole network in previous tick
+  std::vector<unsigned int> spikes;
+  uint64_t numSpikes = 0;
+  uint32_t checksum = 0;
+
+  Barrier barrier(numThreads);
+  auto simulateThread =
+    [&](unsigned int t)
+    {
+      for(uint32_t tick = 1; tick <= numTicks; tick++)
+      {
+        // Simulate this thread's partitions
+        for(unsigned int p = t; p < numPartitions; p += numThreads)
+        {
+          SimulatePartition(partitions[p], tick, spikes, config,
+                            neuronImmutableState, synapseImmutableState);
+        }
+
+        // Once all partitions have been simulated, exchange spikes
+        // **NOTE** partitions are always gathered in the same order
+        // so results don't depend on the number of threads
+        barrier.Wait();
+        if(t == 0)
+        {
+          spikes.clear();
+          for(unsigned int p = 0; p < numPartitions; p++)
+          {
+            for(const unsigned int n : partitions[p].m_Spikes)
+            {
+              const unsigned int s = (p * NumPostNeurons) + n;
+              spikes.push_back(s);
+              checksum = (checksum * 31) + (s ^ tick);
+            }
+          }
+          numSpikes += spikes.size();
+        }
+        barrier.Wait();
+      }
+    };
+
+  // Simulate partitions on worker threads and this one
+  const auto start = std::chrono::high_resolution_clock::now();
+  std::vector<std::thread> threads;
+  for(unsigned int t = 1; t < numThreads; t++)
+  {
+    threads.emplace_back(simulateThread, t);
+  }
+  simulateThread(0);
+  for(auto &thread : threads)
+  {
+    thread.join();
+  }
+  const std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+
+  // Sum synaptic events and learnt weights
+  uint64_t numSynapticEvents = 0;
+  double totalWeight = 0.0;
+  uint64_t numSynapses = 0;
+  for(const auto &partition : partitions)
+  {
+    numSynapticEvents += partition.m_NumSynapticEvents;
+    for(const auto &row : partition.m_Rows)
+    {
+      const PlasticSynapse *plastic =
+        reinterpret_cast<const PlasticSynapse*>(&row[6]);
+      for(unsigned int s = 0; s < row[0]; s++)
+      {
+        totalWeight += (double)plastic[s].GetWeight() / 2048.0;
+      }
+      numSynapses += row[0];
+    }
+  }
+
+  Result result{numSynapticEvents, numSpikes, totalWeight / (double)numSynapses,
+                duration.count(), checksum, {}};
+
+  // Sum plasticity statistics across partitions
+  for(const auto &partition : partitions)
+  {
+    for(unsigned int s = 0; s < SynapseType::StatisticMax; s++)
+    {
+      result.m_Statistics[s] += partition.m_Synapse->GetStatistic((SynapseType::Statistic)s);
+    }
+  }
+  return result;
+}
+//-----------------------------------------------------------------------------
+std::string Trim(const std::string &text)
+{
+  const size_t begin = text.find_first_not_of(" \t\r");
+  const size_t end = text.find_last_not_of(" \t\r");
+  return (begin == std::string::npos) ? std::string() : text.substr(begin, end + 1 - begin);
+}
+//-----------------------------------------------------------------------------
+bool ParseValues(const std::string &text, std::vector<double> &values)
+{
+  // Parse comma-separated list of numbers
+  values.clear();
+  std::stringstream stream(text);
+  std::string item;
+  while(std::getline(stream, item, ','))
+  {
+    item = Trim(item);
+    char *end;
+    const double value = strtod(item.c_str(), &end);
+    if(item.empty() || *end != '\0')
+    {
+      return false;
+    }
+    values.push_back(value);
+  }
+  return !values.empty();
+}
+//-----------------------------------------------------------------------------
+bool SetConfigValue(Config &config, const std::string &key, const std::string &text)
+{
+  // Keys use the names of the equivalent PyNN parameters where there is one
+  const std::map<std::string, double*> scalars = {
+    {"timestep", &config.m_Timestep}, {"duration", &config.m_Duration},
+    {"connection_probability", &config.m_ConnectionProbability},
+    {"min_delay", &config.m_MinDelay}, {"max_delay", &config.m_MaxDelay},
+    {"external_rate", &config.m_ExternalRate}, {"external_weight", &config.m_ExternalWeight},
+    {"v_thresh", &config.m_VThresh}, {"v_reset", &config.m_VReset}, {"v_rest", &config.m_VRest},
+    {"tau_m", &config.m_TauM}, {"cm", &config.m_CM}, {"tau_refrac", &config.m_TauRefrac},
+    {"i_alpha", &config.m_IAlpha}, {"tau_ca2", &config.m_TauCa2}, {"tau_syn_E", &config.m_TauSynE},
+    {"w_min", &config.m_MinWeight}, {"w_max", &config.m_MaxWeight},
+    {"initial_max_weight", &config.m_InitialMaxWeight},
+    {"A_plus", &config.m_APlus}, {"A_minus", &config.m_AMinus}};
+  const std::map<std::string, unsigned int*> integers = {
+    {"num_partitions", &config.m_NumPartitions},
+    {"point_threads", &config.m_NumPointThreads},
+    {"partition_threads", &config.m_NumPartitionThreads}};
+  const std::map<std::string, std::vector<double>*> lists = {
+    {"accumulator_increase", &config.m_AccumulatorIncrease},
+    {"accumulator_decrease", &config.m_AccumulatorDecrease},
+    {"lambda_pre", &config.m_LambdaPre}, {"lambda_post", &config.m_LambdaPost},
+    {"tau_a", &config.m_TauA}};
+
+  std::vector<double> values;
+  if(!ParseValues(text, values))
+  {
+    fprintf(stderr, "Invalid value '%s' for '%s'\n", text.c_str(), key.c_str());
+    return false;
+  }
+
+  const auto scalar = scalars.find(key);
+  const auto integer = integers.find(key);
+  const auto list = lists.find(key);
+  if(scalar != scalars.end() && values.size() == 1)
+  {
+    *scalar->second = values[0];
+    return true;
+  }
+  else if(integer != integers.end() && values.size() == 1
+    && values[0] >= 0.0 && values[0] == std::floor(values[0]))
+  {
+    *integer->second = (unsigned int)values[0];
+    return true;
+  }
+  else if(list != lists.end())
+  {
+    *list->second = values;
+    return true;
+  }
+  else if(scalar != scalars.end() || integer != integers.end())
+  {
+    fprintf(stderr, "'%s' requires a single %s value\n", key.c_str(),
+            (scalar != scalars.end()) ? "numeric" : "non-negative integer");
+    return false;
+  }
+  else
+  {
+    fprintf(stderr, "Unknown configuration key '%s'\n", key.c_str());
+    return false;
+  }
+}
+//-----------------------------------------------------------------------------
+bool ReadConfigLine(Config &config, const std::string &line)
+{
+  // Strip comments and skip blank lines
+  const std::string content = Trim(line.substr(0, line.find('#')));
+  if(content.empty())
+  {
+    return true;
+  }
+
+  // Split 'key = value' line
+  const size_t equals = content.find('=');
+  if(equals == std::string::npos)
+  {
+    fprintf(stderr, "Expected 'key = value' but found '%s'\n", content.c_str());
+    return false;
+  }
+  return SetConfigValue(config, Trim(content.substr(0, equals)), Trim(content.substr(equals + 1)));
+}
+//-----------------------------------------------------------------------------
+bool ReadConfigFile(Config &config, const char *filename)
+{
+  std::ifstream file(filename);
+  if(!file)
+  {
+    fprintf(stderr, "Unable to open configuration file '%s'\n", filename);
+    return false;
+  }
+
+  std::string line;
+  for(unsigned int l = 1; std::getline(file, line); l++)
+  {
+    if(!ReadConfigLine(config, line))
+    {
+      fprintf(stderr, "\tat %s:%u\n", filename, l);
+      return false;
+    }
+  }
+  return true;
+}
+//-----------------------------------------------------------------------------
+bool ValidateConfig(const Config &config)
+{
+  auto check =
+    [](bool valid, const char *message)
+    {
+      if(!valid)
+      {
+        fprintf(stderr, "Invalid configuration: %s\n", message);
+      }
+      return valid;
+    };
+  auto allPositive =
+    [](const std::vector<double> &values)
+    {
+      return std::all_of(values.begin(), values.end(), [](double v){ return v > 0.0; });
+    };
+
+  // **NOTE** window lengths are sampled into 16-bit lookup
+  // tables which must be able to hold ~8 mean lengths in ticks
+  const double maxLambda = std::max(*std::max_element(config.m_LambdaPre.begin(), config.m_LambdaPre.end()),
+                                    *std::max_element(config.m_LambdaPost.begin(), config.m_LambdaPost.end()));
+  return check(config.m_Timestep > 0.0, "timestep must be positive")
+    && check(config.GetNumTicks() > 0, "duration must be at least one timestep")
+    && check(config.m_NumPartitions > 0, "num_partitions must be positive")
+    && check(config.m_NumPartitionThreads > 0 && config.m_NumPartitionThreads <= config.m_NumPartitions,
+             "partition_threads must be between 1 and num_partitions")
+    && check(config.m_ConnectionProbability >= 0.0 && config.m_ConnectionProbability <= 1.0,
+             "connection_probability must be between 0 and 1")
+    && check(config.GetDelayTicks(config.m_MinDelay) > 0, "min_delay must be at least one timestep")
+    && check(config.m_MaxDelay >= config.m_MinDelay, "max_delay must be at least min_delay")
+    && check(config.m_ExternalRate >= 0.0 && (config.m_ExternalRate * config.m_Timestep) <= 1000.0,
+             "external_rate must be between 0 and one spike per timestep")
+    && check(config.m_TauM > 0.0 && config.m_CM > 0.0 && config.m_TauCa2 > 0.0 && config.m_TauSynE > 0.0
+             && config.m_TauRefrac >= 0.0, "neuron time constants and cm must be positive")
+    && check(allPositive(config.m_AccumulatorIncrease) && allPositive(config.m_AccumulatorDecrease)
+             && allPositive(config.m_LambdaPre) && allPositive(config.m_LambdaPost) && allPositive(config.m_TauA),
+             "swept parameters must be positive")
+    && check((maxLambda / config.m_Timestep) * std::log(2048.0) < 65536.0,
+             "lambda_pre and lambda_post are too long for window length lookup tables at this timestep");
+}
+} // Anonymous namespace
+
+//-----------------------------------------------------------------------------
+// Entry point
+//-----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  // Read configuration files and 'key=value' overrides in the order they are given
+  Config config;
+  for(int a = 1; a < argc; a++)
+  {
+    const bool valid = (strchr(argv[a], '=') == NULL) ? ReadConfigFile(config, argv[a])
+      : ReadConfigLine(config, argv[a]);
+    if(!valid)
+    {
+      fprintf(stderr, "Usage: %s [config file] [key=value ...]\n", argv[0]);
+      return 1;
+    }
+  }
+  if(!ValidateConfig(config))
+  {
+    return 1;
+  }
+
+  // If no point thread count is specified, use one per hardware thread
+  if(config.m_NumPointThreads == 0)
+  {
+    config.m_NumPointThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  // Build sweep over learning rule parameters
+  std::vector<SweepPoint> points;
+  for(const double accumulatorIncrease : config.m_AccumulatorIncrease)
+  {
+    for(const double accumulatorDecrease : config.m_AccumulatorDecrease)
+    {
+      for(const double lambdaPre : config.m_LambdaPre)
+      {
+        for(const double lambdaPost : config.m_LambdaPost)
+        {
+          for(const double tauA : config.m_TauA)
+          {
+            points.push_back(SweepPoint{accumulatorIncrease, accumulatorDecrease,
+                                        lambdaPre, lambdaPost, tauA});
+          }
+        }
+      }
+    }
+  }
+
+  // Simulate sweep points on a pool of threads
+  std::vector<Result> results(points.size());
+  std::atomic<unsigned int> nextPoint(0);
+  auto simulatePoints =
+    [&]()
+    {
+      for(unsigned int i = nextPoint++; i < points.size(); i = nextPoint++)
+      {
+        results[i] = Simulate(config, points[i]);
+      }
+    };
+
+  const auto start = std::chrono::high_resolution_clock::now();
+  std::vector<std::thread> threads;
+  for(unsigned int t = 0; t < config.m_NumPointThreads; t++)
+  {
+    threads.emplace_back(simulatePoints);
+  }
+  for(auto &thread : threads)
+  {
+    thread.join();
+  }
+  const std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+
+  // Report results of each sweep point
+  const unsigned int numTicks = config.GetNumTicks();
+  printf("Timestep:%.3fms, %u ticks, %u neurons, delays:%u-%u ticks\n",
+         config.m_Timestep, numTicks, config.m_NumPartitions * NumPostNeurons,
+         config.GetDelayTicks(config.m_MinDelay), config.GetDelayTicks(config.m_MaxDelay));
+  printf("%8s %8s %10s %11s %7s %10s %12s %14s %16s %10s\n",
+         "Acc inc", "Acc dec", "Lambda pre", "Lambda post", "Tau A",
+         "Rate (Hz)", "Mean weight", "Events", "Events/s", "Checksum");
+  uint64_t numSynapticEvents = 0;
+  for(unsigned int i = 0; i < points.size(); i++)
+  {
+    const SweepPoint &point = points[i];
+    const Result &result = results[i];
+    const double rate = (double)result.m_NumSpikes * 1000.0 /
+      ((double)(config.m_NumPartitions * NumPostNeurons) * (double)numTicks * config.m_Timestep);
+    printf("%8.2f %8.2f %10.1f %11.1f %7.1f %10.2f %12.4f %14llu %16.0f %10u\n",
+           point.m_AccumulatorIncrease, point.m_AccumulatorDecrease,
+           point.m_LambdaPre, point.m_LambdaPost, point.m_TauA,
+           rate, result.m_MeanWeight, (unsigned long long)result.m_NumSynapticEvents,
+           (double)result.m_NumSynapticEvents / result.m_Seconds, result.m_Checksum);
+    numSynapticEvents += result.m_NumSynapticEvents;
+  }
+
+  // Report plasticity statistics of each sweep point
+  printf("\n%5s %14s %14s %10s %10s %10s %14s %14s\n",
+         "Point", "Potentiation", "Depression", "Resets", "Overflows",
+         "Flush rows", "Empty windows", "Write-back");
+  for(unsigned int i = 0; i < points.size(); i++)
+  {
+    const uint64_t *statistics = results[i].m_Statistics;
+    printf("%5u %14llu %14llu %10llu %10llu %10llu %14llu %14llu\n", i,
+           (unsigned long long)statistics[SynapseType::StatisticPotentiationEvents],
+           (unsigned long long)statistics[SynapseType::StatisticDepressionEvents],
+           (unsigned long long)statistics[SynapseType::StatisticAccumulatorResets],
+           (unsigned long long)statistics[SynapseType::StatisticPostHistoryOverflows],
+           (unsigned long long)statistics[SynapseType::StatisticFlushRows],
+           (unsigned long long)statistics[SynapseType::StatisticEmptyWindowSynapses],
+           (unsigned long long)statistics[SynapseType::StatisticWriteBackWords]);
+  }
+
+  // Report throughput of whole sweep
+  const double simulatedSeconds = (double)points.size() * (double)numTicks * config.m_Timestep / 1000.0;
+  printf("\n%u points, %u x %u threads, %.2fs: %.0f synaptic events/s, %.1fx real-time\n",
+         (unsigned int)points.size(), config.m_NumPointThreads, config.m_NumPartitionThreads, duration.count(),
+         (double)numSynapticEvents / duration.count(), simulatedSeconds / duration.count());
+  return 0;
+}
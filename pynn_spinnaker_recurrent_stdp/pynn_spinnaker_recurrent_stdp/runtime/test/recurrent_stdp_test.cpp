@@ -0,0 +1,458 @@
+// Standard includes
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Common includes
+#include "common/random/mars_kiss64.h"
+
+// Recurrent STDP includes
+#include "../compressed_post_events.h"
+#include "../recurrent_stdp.h"
+
+//-----------------------------------------------------------------------------
+// Anonymous namespace
+//-----------------------------------------------------------------------------
+namespace
+{
+//-----------------------------------------------------------------------------
+// Constants
+//-----------------------------------------------------------------------------
+// Template arguments matching build/config.h
+const unsigned int ControlDelayBits = 3;
+const unsigned int ControlIndexBits = 10;
+const unsigned int MaxAxonalDelay = 0;
+const unsigned int RingBufferDelayBits = 3;
+const unsigned int TauALUTNumEntries = 512;
+const unsigned int TauALUTShift = 5;
+const unsigned int NumParamSets = 1;
+
+// Number of post-synaptic neurons handled by a synapse processor
+const unsigned int NumPostNeurons = 256;
+
+// Maximum number of synapses in a row
+const unsigned int MaxRowSynapses = 170;
+
+// Number of delay slots which can be encoded in control words
+const unsigned int NumDelaySlots = 1 << ControlDelayBits;
+
+// Number of delay slots in the stub ring-buffer
+const unsigned int NumRingBufferDelaySlots = 1 << RingBufferDelayBits;
+
+// Number of distinct presynaptic rows to cycle through
+const unsigned int NumRows = 512;
+
+// Number of rows processed each simulated tick
+const unsigned int RowsPerTick = 32;
+
+// Probability of each post-synaptic neuron spiking each tick
+const double PostRate = 0.05;
+
+// Plasticity parameters written into the synthetic SDRAM region
+const double MeanPreWindow = 20.0;
+const double MeanPostWindow = 20.0;
+const double TauA = 100.0;
+
+//-----------------------------------------------------------------------------
+// Post-synaptic event history types
+//-----------------------------------------------------------------------------
+template<typename T, unsigned int N>
+using Standard = SynapseProcessor::Plasticity::PostEventHistory<T, N>;
+
+template<typename T, unsigned int N>
+using Compressed = ExtraModels::CompressedPostEventHistory<T, N>;
+
+//-----------------------------------------------------------------------------
+// Plastic synapse types
+//-----------------------------------------------------------------------------
+typedef ExtraModels::WeightAccumulator32 Wide;
+typedef ExtraModels::WeightAccumulator16 Compact;
+
+//-----------------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------------
+int16_t ToS2011(double value)
+{
+  return (int16_t)std::round(value * 2048.0);
+}
+//-----------------------------------------------------------------------------
+void WriteExpDistLUT(std::vector<uint32_t> &region, double mean)
+{
+  // Header describing table
+  region.push_back(ExtraModels::LUTHeader::Build(ExtraModels::LUTHeader::TypeInverseTransformSample, 2048, 0));
+  region.push_back((uint32_t)std::round(mean));
+
+  // Inverse CDF of exponential distribution
+  // sampled with 11 fractional bits of probability
+  std::vector<uint16_t> lut(2048);
+  for(unsigned int i = 0; i < 2048; i++)
+  {
+    const double p = (double)i / 2048.0;
+    lut[i] = (uint16_t)std::round(-mean * std::log(1.0 - p));
+  }
+
+  const size_t start = region.size();
+  region.resize(start + (lut.size() / 2));
+  memcpy(&region[start], lut.data(), lut.size() * sizeof(uint16_t));
+}
+//-----------------------------------------------------------------------------
+void WriteExpDecayLUT(std::vector<uint32_t> &region, double tau,
+                      unsigned int numEntries, unsigned int shift)
+{
+  // Header describing table
+  region.push_back(ExtraModels::LUTHeader::Build(ExtraModels::LUTHeader::TypeExpDecay, numEntries, shift));
+  region.push_back((uint32_t)std::round(tau));
+
+  // Exponential decay in S2011 format
+  std::vector<int16_t> lut(numEntries + (numEntries % 2));
+  for(unsigned int i = 0; i < numEntries; i++)
+  {
+    lut[i] = ToS2011(std::exp(-(double)(i << shift) / tau));
+  }
+
+  const size_t start = region.size();
+  region.resize(start + (lut.size() / 2));
+  memcpy(&region[start], lut.data(), lut.size() * sizeof(int16_t));
+}
+//-----------------------------------------------------------------------------
+std::vector<uint32_t> BuildPlasticityRegion(uint32_t seed, double tauA)
+{
+  std::vector<uint32_t> region;
+
+  // RNG seed
+  std::mt19937 seedGenerator(seed);
+  for(unsigned int s = 0; s < Common::Random::MarsKiss64::StateSize; s++)
+  {
+    region.push_back(seedGenerator());
+  }
+
+  // Plasticity is never switched off
+  region.push_back(0);
+  region.push_back(0);
+
+  // Postsynaptic window length distribution
+  WriteExpDistLUT(region, MeanPostWindow);
+
+  // Identical parameter sets
+  for(unsigned int p = 0; p < NumParamSets; p++)
+  {
+    // Weight limits, weight update sizes and accumulator steps
+    region.push_back((uint32_t)(int32_t)ToS2011(0.0));
+    region.push_back((uint32_t)(int32_t)ToS2011(1.0));
+    region.push_back((uint32_t)(int32_t)ToS2011(0.1));
+    region.push_back((uint32_t)(int32_t)ToS2011(0.1));
+    region.push_back((uint32_t)(int32_t)ToS2011(0.2));
+    region.push_back((uint32_t)(int32_t)ToS2011(0.2));
+
+    // Axonal delay
+    region.push_back(0);
+
+    // Presynaptic window length distribution
+    WriteExpDistLUT(region, MeanPreWindow);
+
+    // Accumulator decay
+    WriteExpDecayLUT(region, tauA, TauALUTNumEntries, TauALUTShift);
+  }
+  return region;
+}
+//-----------------------------------------------------------------------------
+template<typename P, typename SynapseType>
+std::vector<std::vector<uint32_t>> BuildRows(const SynapseType &synapse, uint32_t seed)
+{
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<uint32_t> weightDist(0, 2048);
+  std::uniform_int_distribution<uint32_t> indexDist(0, NumPostNeurons - 1);
+  std::uniform_int_distribution<uint32_t> delayDist(1, NumDelaySlots - 1);
+
+  std::vector<std::vector<uint32_t>> rows;
+  for(unsigned int r = 0; r < NumRows; r++)
+  {
+    std::vector<uint32_t> row(synapse.GetRowWords(MaxRowSynapses), 0);
+
+    // Synapse count; no delay extension; last update, last pre-spike and trace all zero
+    row[0] = MaxRowSynapses;
+
+    // Plastic synapses start after five header words and the pre-trace
+    // and the 16-bit control words fill the end of the row
+    const unsigned int controlWords = (MaxRowSynapses + 1) / 2;
+    P *plastic = reinterpret_cast<P*>(&row[6]);
+    uint16_t *control = reinterpret_cast<uint16_t*>(&row[row.size() - controlWords]);
+    for(unsigned int s = 0; s < MaxRowSynapses; s++)
+    {
+      // Random weight and zero accumulator
+      plastic[s] = P(weightDist(rng), 0);
+
+      control[s] = (uint16_t)(indexDist(rng) | (delayDist(rng) << ControlIndexBits));
+    }
+
+    rows.push_back(row);
+  }
+  return rows;
+}
+//-----------------------------------------------------------------------------
+template<typename SynapseType>
+void Simulate(SynapseType &synapse, std::vector<std::vector<uint32_t>> &rows,
+              std::vector<uint32_t> &ringBuffer, std::mt19937 &rng,
+              unsigned int beginTick, unsigned int endTick)
+{
+  static uint32_t dmaBuffer[SynapseType::MaxRowWords];
+
+  std::bernoulli_distribution postSpikeDist(PostRate);
+  std::uniform_int_distribution<unsigned int> rowDist(0, NumRows - 1);
+
+  auto applyInput = [&ringBuffer](unsigned int tick, unsigned int index, int weight)
+  {
+    ringBuffer[((tick % NumRingBufferDelaySlots) * NumPostNeurons) + index] += weight;
+  };
+  auto addDelayRow = [](unsigned int, uint32_t, bool)
+  {
+  };
+  auto writeBackRow = [](uint32_t *sdramAddress, uint32_t *localAddress, unsigned int numWords)
+  {
+    memcpy(sdramAddress, localAddress, numWords * sizeof(uint32_t));
+  };
+
+  for(unsigned int tick = beginTick; tick < endTick; tick++)
+  {
+    // Back-propagate spikes from post-synaptic neurons
+    for(unsigned int n = 0; n < NumPostNeurons; n++)
+    {
+      if(postSpikeDist(rng))
+      {
+        synapse.AddPostSynapticSpike(tick, n);
+      }
+    }
+
+    // 'DMA' and process random rows
+    for(unsigned int r = 0; r < RowsPerTick; r++)
+    {
+      auto &row = rows[rowDist(rng)];
+      memcpy(dmaBuffer, row.data(), row.size() * sizeof(uint32_t));
+      synapse.ProcessRow(tick, dmaBuffer, row.data(), false,
+                         applyInput, addDelayRow, writeBackRow);
+    }
+  }
+}
+//-----------------------------------------------------------------------------
+// Check that restoring checkpointed learning state continues identically
+// to the simulation it was saved from and that a configuration whose learning
+// state is the same size but whose accumulator decay differs refuses to load it
+template<typename P, template<typename, unsigned int> class H, unsigned int T>
+bool TestCheckpoint(const char *format, unsigned int numTicks)
+{
+  typedef ExtraModels::RecurrentSTDP<uint16_t, P, ControlDelayBits, ControlIndexBits, MaxAxonalDelay,
+                                     NumPostNeurons, MaxRowSynapses,
+                                     TauALUTNumEntries, TauALUTShift, NumParamSets,
+                                     H, T, Common::Random::MarsKiss64> SynapseType;
+
+  // Load synapse type and rows and simulate first half of ticks
+  std::unique_ptr<SynapseType> synapse(new SynapseType());
+  std::vector<uint32_t> region = BuildPlasticityRegion(1234, TauA);
+  synapse->ReadSDRAMData(region.data(), 0, 0);
+  std::vector<std::vector<uint32_t>> rows = BuildRows<P>(*synapse, 5678);
+  std::vector<uint32_t> ringBuffer(NumRingBufferDelaySlots * NumPostNeurons, 0);
+  std::mt19937 rng(4321);
+  const unsigned int checkpointTick = 1 + (numTicks / 2);
+  Simulate(*synapse, rows, ringBuffer, rng, 1, checkpointTick);
+
+  // Checkpoint learning state, the learning state held in each row and the spike source
+  std::vector<uint32_t> state(SynapseType::StateWords, 0);
+  synapse->WriteStateSDRAMData(state.data());
+  std::vector<uint32_t> rowState;
+  for(const auto &row : rows)
+  {
+    const size_t start = rowState.size();
+    rowState.resize(start + SynapseType::GetRowStateWords(row[0]));
+    uint32_t *rowStateEnd = &rowState[start];
+    SynapseType::WriteRowState(row.data(), rowStateEnd);
+  }
+  std::mt19937 restoredRNG(rng);
+
+  // Load a fresh synapse type from the same region, rebuild the rows as
+  // they were before simulation, as the host would when reloading, and restore
+  std::unique_ptr<SynapseType> restoredSynapse(new SynapseType());
+  restoredSynapse->ReadSDRAMData(region.data(), 0, 0);
+  std::vector<std::vector<uint32_t>> restoredRows = BuildRows<P>(*restoredSynapse, 5678);
+  bool loaded = restoredSynapse->ReadStateSDRAMData(state.data());
+  const uint32_t *rowStateBegin = rowState.data();
+  for(auto &row : restoredRows)
+  {
+    loaded = SynapseType::ReadRowState(row.data(), rowStateBegin) && loaded;
+  }
+
+  // Load checkpoint into a configuration with different accumulator decay
+  std::unique_ptr<SynapseType> otherSynapse(new SynapseType());
+  std::vector<uint32_t> otherRegion = BuildPlasticityRegion(1234, TauA * 2.0);
+  otherSynapse->ReadSDRAMData(otherRegion.data(), 0, 0);
+  const bool rejectsOtherConfig = !otherSynapse->ReadStateSDRAMData(state.data());
+
+  // Continue both the original and restored synapse types for the second half of ticks
+  std::vector<uint32_t> restoredRingBuffer(ringBuffer);
+  Simulate(*synapse, rows, ringBuffer, rng, checkpointTick, numTicks + 1);
+  Simulate(*restoredSynapse, restoredRows, restoredRingBuffer, restoredRNG,
+           checkpointTick, numTicks + 1);
+
+  // Continuation is only identical if the input and learnt weights match
+  const bool identical = loaded && (ringBuffer == restoredRingBuffer) && (rows == restoredRows);
+  printf("%-32s %7u %7u %10s %8s\n", format, (unsigned int)(sizeof(P) * 8), T,
+         identical ? "yes" : "NO", rejectsOtherConfig ? "yes" : "NO");
+  return identical && rejectsOtherConfig;
+}
+//-----------------------------------------------------------------------------
+// Compare every window of a compressed history against those of a standard
+// history containing the same events, walking them as RecurrentSTDP does
+// with each event applied after a dendritic delay. Returns number of mismatched windows
+unsigned int CompareCompressedHistory(const std::vector<uint32_t> &times, uint32_t delay)
+{
+  // Histories large enough that no events are evicted
+  const unsigned int HistorySize = 255;
+  Standard<uint16_t, HistorySize> standard;
+  Compressed<uint16_t, HistorySize> compressed;
+  for(unsigned int i = 0; i < times.size(); i++)
+  {
+    standard.Add(times[i], (uint16_t)(i + 1));
+    compressed.Add(times[i], (uint16_t)(i + 1));
+  }
+
+  // Build list of interesting window boundaries
+  std::vector<uint32_t> boundaries = {0};
+  for(const uint32_t t : times)
+  {
+    boundaries.push_back((t > 0) ? (t - 1) : 0);
+    boundaries.push_back(t);
+    boundaries.push_back(t + 1);
+  }
+
+  unsigned int numMismatches = 0;
+  for(const uint32_t begin : boundaries)
+  {
+    for(const uint32_t end : boundaries)
+    {
+      if(end < begin)
+      {
+        continue;
+      }
+
+      // Walk both windows, comparing previous and next events
+      auto s = standard.GetWindow(begin, end);
+      auto c = compressed.GetWindow(begin, end);
+      bool match = (s.GetNumEvents() == c.GetNumEvents());
+      while(match)
+      {
+        match = (s.GetPrevTime() == c.GetPrevTime() && s.GetPrevTrace() == c.GetPrevTrace());
+        if(!match || s.GetNumEvents() == 0)
+        {
+          break;
+        }
+
+        match = (s.GetNextTime() == c.GetNextTime() && s.GetNextTrace() == c.GetNextTrace());
+        s.Next(s.GetNextTime() + delay);
+        c.Next(c.GetNextTime() + delay);
+      }
+
+      if(!match)
+      {
+        numMismatches++;
+      }
+    }
+  }
+
+  // Check most recent event matches
+  if(standard.GetLastTime() != compressed.GetLastTime()
+    || standard.GetLastTrace() != compressed.GetLastTrace())
+  {
+    numMismatches++;
+  }
+
+  return numMismatches;
+}
+//-----------------------------------------------------------------------------
+unsigned int CheckCompressedHistory(const char *name, const std::vector<std::vector<uint32_t>> &spikeTrains)
+{
+  unsigned int numEvents = 0;
+  unsigned int numMismatches = 0;
+  for(const auto &times : spikeTrains)
+  {
+    numEvents += times.size();
+
+    // **NOTE** a non-zero delay checks that the previous time of each window
+    // is the delayed time passed to Next rather than the time of the event
+    numMismatches += CompareCompressedHistory(times, 0);
+    numMismatches += CompareCompressedHistory(times, 7);
+  }
+
+  printf("%-32s %7u %10u %10s\n", name, numEvents,
+         numMismatches, (numMismatches == 0) ? "yes" : "NO");
+  return numMismatches;
+}
+//-----------------------------------------------------------------------------
+unsigned int RunCompressedHistoryChecks()
+{
+  unsigned int numMismatches = 0;
+
+  // Spike at tick 0 coincides with initial event
+  numMismatches += CheckCompressedHistory("tick zero", {{0, 3, 10}});
+
+  // Several spikes in the same tick (zero offsets)
+  numMismatches += CheckCompressedHistory("same tick", {{5, 5, 5, 6, 6, 300, 300}});
+
+  // Offsets either side of the largest which fits alongside an
+  // event and ones requiring one or more extension entries
+  numMismatches += CheckCompressedHistory("extension boundary",
+                                          {{254, 508, 763, 763, 70000, 70000, 270000}});
+
+  // Random spike trains with frequent coincident spikes and occasional long gaps
+  std::mt19937 rng(4321);
+  std::uniform_int_distribution<uint32_t> gap(0, 4);
+  std::uniform_int_distribution<uint32_t> longGap(0, 200000);
+  std::bernoulli_distribution isLongGap(0.05);
+  std::vector<std::vector<uint32_t>> spikeTrains(20);
+  for(auto &times : spikeTrains)
+  {
+    uint32_t t = 0;
+    for(unsigned int i = 0; i < 60; i++)
+    {
+      t += isLongGap(rng) ? longGap(rng) : gap(rng);
+      times.push_back(t);
+    }
+  }
+  numMismatches += CheckCompressedHistory("random", spikeTrains);
+
+  return numMismatches;
+}
+} // Anonymous namespace
+
+//-----------------------------------------------------------------------------
+// Entry point
+//-----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  // Read number of ticks to simulate for each configuration
+  const unsigned int numTicks = (argc > 1) ? (unsigned int)atoi(argv[1]) : 2000;
+
+  unsigned int numFailures = 0;
+
+  // Check compressed post-synaptic event history against standard
+  // history including the edge cases that simulation rarely hits
+  printf("%-32s %7s %10s %10s\n", "Compressed history", "Events", "Mismatches", "Identical");
+  numFailures += (RunCompressedHistoryChecks() == 0) ? 0 : 1;
+  printf("\n");
+
+  printf("%-32s %7s %7s %10s %8s\n", "Checkpoint", "Synapse", "History", "Identical", "Rejects");
+  numFailures += TestCheckpoint<Wide, Standard, 10>("standard", numTicks) ? 0 : 1;
+  numFailures += TestCheckpoint<Wide, Compressed, 20>("compressed", numTicks) ? 0 : 1;
+  numFailures += TestCheckpoint<Compact, Compressed, 20>("compressed", numTicks) ? 0 : 1;
+
+  if(numFailures != 0)
+  {
+    fprintf(stderr, "%u tests failed\n", numFailures);
+    return 1;
+  }
+  printf("\nAll tests passed\n");
+  return 0;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+// Standard includes
+#include <cstdint>
+
+// Common includes
+#include "common/fixed_point_number.h"
+
+// Namespaces
+using namespace Common::FixedPointNumber;
+
+//-----------------------------------------------------------------------------
+// ExtraModels::WeightAccumulator32
+//-----------------------------------------------------------------------------
+// Plastic synapse consisting of a 16-bit weight and a 16-bit S2011 accumulator
+namespace ExtraModels
+{
+class WeightAccumulator32
+{
+public:
+  WeightAccumulator32(){}
+  WeightAccumulator32(int32_t weight, S2011 accumulator)
+    : m_HalfWords{(uint16_t)weight, (uint16_t)accumulator}
+  {
+  }
+
+  //-----------------------------------------------------------------------------
+  // Public API
+  //-----------------------------------------------------------------------------
+  int32_t GetWeight() const{ return (int32_t)m_HalfWords[0]; }
+  S2011 GetAccumulator() const{ return (int32_t)m_HalfWords[1]; }
+
+  // Weight to add to ring-buffer
+  int32_t GetInputWeight() const{ return (int32_t)m_HalfWords[0]; }
+
+  bool operator != (const WeightAccumulator32 &other) const
+  {
+    return (m_Word != other.m_Word);
+  }
+
+private:
+  //-----------------------------------------------------------------------------
+  // Members
+  //-----------------------------------------------------------------------------
+  union
+  {
+    uint16_t m_HalfWords[2];
+    uint32_t m_Word;
+  };
+};
+
+//-----------------------------------------------------------------------------
+// ExtraModels::WeightAccumulator16
+//-----------------------------------------------------------------------------
+// Plastic synapse consisting of an 8-bit weight in the low byte and an 8-bit
+// accumulator with 6 fractional bits in the high byte. Weights are stored
+// (and added to the ring-buffer) with 8 fewer fractional bits than those of
+// WeightAccumulator32 but are exposed in the same format so the same learning
+// rule parameters can be used with both
+class WeightAccumulator16
+{
+private:
+  //-----------------------------------------------------------------------------
+  // Constants
+  //-----------------------------------------------------------------------------
+  static const unsigned int WeightShift = 8;
+  static const unsigned int AccumulatorShift = 5;
+
+public:
+  WeightAccumulator16(){}
+  WeightAccumulator16(int32_t weight, S2011 accumulator)
+    : m_HalfWord((uint16_t)(Round(weight, WeightShift, 0, 255) |
+                            ((Round(accumulator, AccumulatorShift, -128, 127) & 0xFF) << 8)))
+  {
+  }
+
+  //-----------------------------------------------------------------------------
+  // Public API
+  //-----------------------------------------------------------------------------
+  int32_t GetWeight() const{ return GetInputWeight() << WeightShift; }
+  S2011 GetAccumulator() const{ return (int32_t)(int8_t)(m_HalfWord >> 8) * (1 << AccumulatorShift); }
+
+  // Weight to add to ring-buffer
+  int32_t GetInputWeight() const{ return (int32_t)(m_HalfWord & 0xFF); }
+
+  bool operator != (const WeightAccumulator16 &other) const
+  {
+    return (m_HalfWord != other.m_HalfWord);
+  }
+
+private:
+  //-----------------------------------------------------------------------------
+  // Private static methods
+  //-----------------------------------------------------------------------------
+  static int32_t Round(int32_t value, unsigned int shift, int32_t min, int32_t max)
+  {
+    // Round value to nearest after shifting and clamp to range
+    const int32_t rounded = (value + (1 << (shift - 1))) >> shift;
+    return (rounded < min) ? min : ((rounded > max) ? max : rounded);
+  }
+
+  //-----------------------------------------------------------------------------
+  // Members
+  //-----------------------------------------------------------------------------
+  uint16_t m_HalfWord;
+};
+} // ExtraModels
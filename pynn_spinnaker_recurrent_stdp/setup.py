@@ -4,7 +4,8 @@ setup(
     name="pynn_spinnaker_recurrent_stdp",
     version="0.1.0",
     packages=find_packages(),
-    package_data={'pynn_spinnaker_recurrent_stdp': ['binaries/*.aplx']},
+    package_data={'pynn_spinnaker_recurrent_stdp': ['binaries/*.aplx',
+                                                   'binaries/*.so']},
 
     # Metadata for PyPi
     url="https://github.com/project-rig/pynn_spinnaker_extra_models",